@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Atomic, since the parallel benchmarks allocate from several threads
+std::atomic<std::size_t> s_allocationCount(0);
+std::atomic<std::size_t> s_allocatedBytes(0);
+
+volatile std::size_t s_sink = 0;
+
+int openCacheMissesCounter()
+{
+#ifdef __linux__
+  perf_event_attr attributes;
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.type = PERF_TYPE_HARDWARE;
+  attributes.size = sizeof(attributes);
+  attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+  attributes.disabled = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+  return -1;
+#endif
+}
+
+}
+
+// Replace the global allocation functions to count heap allocations. All other forms (array,
+// nothrow) end up calling these
+void *operator new(std::size_t size)
+{
+  s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+  s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  void *p = std::malloc(size ? size : 1);
+  if (! p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t /*size*/) noexcept
+{
+  std::free(p);
+}
+
+BenchmarkCounters::BenchmarkCounters()
+: m_elapsedTime(0),
+  m_startAllocations(0),
+  m_allocations(0),
+  m_startAllocatedBytes(0),
+  m_allocatedBytes(0),
+  m_cacheMissesFd(openCacheMissesCounter()),
+  m_cacheMisses(-1)
+{}
+
+BenchmarkCounters::~BenchmarkCounters()
+{
+#ifdef __linux__
+  if (m_cacheMissesFd >= 0) {
+    close(m_cacheMissesFd);
+  }
+#endif
+}
+
+void BenchmarkCounters::start()
+{
+#ifdef __linux__
+  if (m_cacheMissesFd >= 0) {
+    ioctl(m_cacheMissesFd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(m_cacheMissesFd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+  m_startAllocations = s_allocationCount.load(std::memory_order_relaxed);
+  m_startAllocatedBytes = s_allocatedBytes.load(std::memory_order_relaxed);
+  m_startTime = std::chrono::steady_clock::now();
+}
+
+void BenchmarkCounters::stop()
+{
+  m_elapsedTime = std::chrono::steady_clock::now() - m_startTime;
+  m_allocations = s_allocationCount.load(std::memory_order_relaxed) - m_startAllocations;
+  m_allocatedBytes = s_allocatedBytes.load(std::memory_order_relaxed) - m_startAllocatedBytes;
+#ifdef __linux__
+  if (m_cacheMissesFd >= 0) {
+    ioctl(m_cacheMissesFd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(m_cacheMissesFd, &m_cacheMisses, sizeof(m_cacheMisses)) != sizeof(m_cacheMisses)) {
+      m_cacheMisses = -1;
+    }
+  }
+#endif
+}
+
+double BenchmarkCounters::elapsedNanoseconds() const
+{
+  return std::chrono::duration<double, std::nano>(m_elapsedTime).count();
+}
+
+std::size_t BenchmarkCounters::allocations() const
+{
+  return m_allocations;
+}
+
+/**
+ * Bytes allocated between start() and stop(). Frees are not subtracted
+ */
+std::size_t BenchmarkCounters::allocatedBytes() const
+{
+  return m_allocatedBytes;
+}
+
+long long BenchmarkCounters::cacheMisses() const
+{
+  return m_cacheMisses;
+}
+
+/**
+ * The largest list size can be given as first command-line argument
+ */
+std::size_t benchmarkMaxSize(int argc, char *argv[], std::size_t defaultMaxSize)
+{
+  if (argc < 2) {
+    return defaultMaxSize;
+  }
+  std::size_t maxSize = std::strtoul(argv[1], 0, 10);
+  return maxSize != 0 ? maxSize : defaultMaxSize;
+}
+
+void printBenchmarkHeader()
+{
+  std::printf("%-24s %10s %12s %12s %16s\n", "operation", "size", "ns/op", "allocs/op", "cache-misses/op");
+}
+
+void printBenchmarkResult(const char *operation, std::size_t size, std::size_t operations,
+  const BenchmarkCounters &counters)
+{
+  double ops = static_cast<double>(operations);
+  std::printf("%-24s %10lu %12.2f %12.2f ", operation, static_cast<unsigned long>(size),
+    counters.elapsedNanoseconds() / ops, counters.allocations() / ops);
+  if (counters.cacheMisses() >= 0) {
+    std::printf("%16.3f\n", counters.cacheMisses() / ops);
+  }
+  else {
+    std::printf("%16s\n", "n/a");
+  }
+}
+
+void doNotOptimize(std::size_t value)
+{
+  s_sink = s_sink + value;
+}
@@ -0,0 +1,58 @@
+/**
+ * Minimal micro-benchmarking support for the list samples
+ *   - wall-clock time, measured with a monotonic clock
+ *   - number and total size of heap allocations (the global operator new is replaced in
+ *     Benchmark.cpp). Sizes are the requested ones, without the allocator overhead
+ *   - hardware cache misses, where performance counters are available (Linux perf events)
+ * Results are printed as one line per operation and list size, normalized per element
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+
+class BenchmarkCounters {
+public:
+  BenchmarkCounters();
+  ~BenchmarkCounters();
+
+  void start();
+  void stop();
+
+  double elapsedNanoseconds() const;
+  std::size_t allocations() const;
+  std::size_t allocatedBytes() const;
+
+  // Negative if no hardware counter is available
+  long long cacheMisses() const;
+
+private:
+  // Not copyable
+  BenchmarkCounters(const BenchmarkCounters &rhs);
+  BenchmarkCounters &operator=(const BenchmarkCounters &rhs);
+
+  std::chrono::steady_clock::time_point m_startTime;
+  std::chrono::steady_clock::duration m_elapsedTime;
+
+  std::size_t m_startAllocations;
+  std::size_t m_allocations;
+  std::size_t m_startAllocatedBytes;
+  std::size_t m_allocatedBytes;
+
+  // Performance counter file descriptor, negative if unavailable
+  int m_cacheMissesFd;
+  long long m_cacheMisses;
+};
+
+std::size_t benchmarkMaxSize(int argc, char *argv[], std::size_t defaultMaxSize);
+
+void printBenchmarkHeader();
+void printBenchmarkResult(const char *operation, std::size_t size, std::size_t operations,
+  const BenchmarkCounters &counters);
+
+// Store a result where the optimizer cannot discard it
+void doNotOptimize(std::size_t value);
+
+#endif
@@ -0,0 +1,456 @@
+#include "BlockSearch.h"
+
+#ifndef BLOCKSEARCH_SIMD
+#define BLOCKSEARCH_SIMD 1
+#endif
+
+#if BLOCKSEARCH_SIMD && defined(__GNUC__) && defined(__x86_64__)
+#define BLOCKSEARCH_X86 1
+#include <immintrin.h>
+#else
+#define BLOCKSEARCH_X86 0
+#endif
+
+namespace {
+
+template<class T>
+struct BlockKernels {
+  std::size_t (*m_find)(const T *pValues, std::size_t count, const T &value);
+  std::size_t (*m_count)(const T *pValues, std::size_t count, const T &value);
+  std::size_t (*m_min)(const T *pValues, std::size_t count);
+  std::size_t (*m_max)(const T *pValues, std::size_t count);
+};
+
+#if BLOCKSEARCH_X86
+
+// The vector loops leave the last count % lanes values to the scalar loops. min and max reduce
+// the block to its smallest or largest value, then look for its first occurrence
+
+std::size_t findIntSse2(const int *pValues, std::size_t count, const int &value)
+{
+  const __m128i needle = _mm_set1_epi32(value);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues + i));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, needle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalarBlockFind(pValues + i, count - i, value);
+}
+
+std::size_t countIntSse2(const int *pValues, std::size_t count, const int &value)
+{
+  const __m128i needle = _mm_set1_epi32(value);
+  std::size_t equalCount = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues + i));
+    equalCount += __builtin_popcount(
+      _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, needle))));
+  }
+  return equalCount + scalarBlockCount(pValues + i, count - i, value);
+}
+
+// SSE2 has no 32-bit integer min and max: Lanes are selected with the comparison mask
+std::size_t minIntSse2(const int *pValues, std::size_t count)
+{
+  if (count < 4) {
+    return scalarBlockMin(pValues, count);
+  }
+
+  __m128i minValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues));
+  std::size_t i = 4;
+  for (; i + 4 <= count; i += 4) {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues + i));
+    __m128i isLess = _mm_cmplt_epi32(values, minValues);
+    minValues = _mm_or_si128(_mm_and_si128(isLess, values), _mm_andnot_si128(isLess, minValues));
+  }
+
+  int lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), minValues);
+  int minValue = lanes[scalarBlockMin(lanes, 4)];
+  for (; i < count; ++i) {
+    if (pValues[i] < minValue) {
+      minValue = pValues[i];
+    }
+  }
+  return findIntSse2(pValues, count, minValue);
+}
+
+std::size_t maxIntSse2(const int *pValues, std::size_t count)
+{
+  if (count < 4) {
+    return scalarBlockMax(pValues, count);
+  }
+
+  __m128i maxValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues));
+  std::size_t i = 4;
+  for (; i + 4 <= count; i += 4) {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pValues + i));
+    __m128i isGreater = _mm_cmpgt_epi32(values, maxValues);
+    maxValues = _mm_or_si128(_mm_and_si128(isGreater, values),
+      _mm_andnot_si128(isGreater, maxValues));
+  }
+
+  int lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), maxValues);
+  int maxValue = lanes[scalarBlockMax(lanes, 4)];
+  for (; i < count; ++i) {
+    if (maxValue < pValues[i]) {
+      maxValue = pValues[i];
+    }
+  }
+  return findIntSse2(pValues, count, maxValue);
+}
+
+__attribute__((target("avx2")))
+std::size_t findIntAvx2(const int *pValues, std::size_t count, const int &value)
+{
+  const __m256i needle = _mm256_set1_epi32(value);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues + i));
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, needle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalarBlockFind(pValues + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+std::size_t countIntAvx2(const int *pValues, std::size_t count, const int &value)
+{
+  const __m256i needle = _mm256_set1_epi32(value);
+  std::size_t equalCount = 0;
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues + i));
+    equalCount += __builtin_popcount(
+      _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, needle))));
+  }
+  return equalCount + scalarBlockCount(pValues + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+std::size_t minIntAvx2(const int *pValues, std::size_t count)
+{
+  if (count < 8) {
+    return scalarBlockMin(pValues, count);
+  }
+
+  __m256i minValues = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues));
+  std::size_t i = 8;
+  for (; i + 8 <= count; i += 8) {
+    minValues = _mm256_min_epi32(minValues,
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues + i)));
+  }
+
+  int lanes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), minValues);
+  int minValue = lanes[scalarBlockMin(lanes, 8)];
+  for (; i < count; ++i) {
+    if (pValues[i] < minValue) {
+      minValue = pValues[i];
+    }
+  }
+  return findIntAvx2(pValues, count, minValue);
+}
+
+__attribute__((target("avx2")))
+std::size_t maxIntAvx2(const int *pValues, std::size_t count)
+{
+  if (count < 8) {
+    return scalarBlockMax(pValues, count);
+  }
+
+  __m256i maxValues = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues));
+  std::size_t i = 8;
+  for (; i + 8 <= count; i += 8) {
+    maxValues = _mm256_max_epi32(maxValues,
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pValues + i)));
+  }
+
+  int lanes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), maxValues);
+  int maxValue = lanes[scalarBlockMax(lanes, 8)];
+  for (; i < count; ++i) {
+    if (maxValue < pValues[i]) {
+      maxValue = pValues[i];
+    }
+  }
+  return findIntAvx2(pValues, count, maxValue);
+}
+
+std::size_t findDoubleSse2(const double *pValues, std::size_t count, const double &value)
+{
+  const __m128d needle = _mm_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(pValues + i), needle));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalarBlockFind(pValues + i, count - i, value);
+}
+
+std::size_t countDoubleSse2(const double *pValues, std::size_t count, const double &value)
+{
+  const __m128d needle = _mm_set1_pd(value);
+  std::size_t equalCount = 0;
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    equalCount += __builtin_popcount(
+      _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(pValues + i), needle)));
+  }
+  return equalCount + scalarBlockCount(pValues + i, count - i, value);
+}
+
+std::size_t minDoubleSse2(const double *pValues, std::size_t count)
+{
+  if (count < 2) {
+    return scalarBlockMin(pValues, count);
+  }
+
+  __m128d minValues = _mm_loadu_pd(pValues);
+  std::size_t i = 2;
+  for (; i + 2 <= count; i += 2) {
+    minValues = _mm_min_pd(minValues, _mm_loadu_pd(pValues + i));
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, minValues);
+  double minValue = lanes[scalarBlockMin(lanes, 2)];
+  for (; i < count; ++i) {
+    if (pValues[i] < minValue) {
+      minValue = pValues[i];
+    }
+  }
+  // With NaN in the block, the reduced value may not be found
+  std::size_t index = findDoubleSse2(pValues, count, minValue);
+  return index < count ? index : scalarBlockMin(pValues, count);
+}
+
+std::size_t maxDoubleSse2(const double *pValues, std::size_t count)
+{
+  if (count < 2) {
+    return scalarBlockMax(pValues, count);
+  }
+
+  __m128d maxValues = _mm_loadu_pd(pValues);
+  std::size_t i = 2;
+  for (; i + 2 <= count; i += 2) {
+    maxValues = _mm_max_pd(maxValues, _mm_loadu_pd(pValues + i));
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, maxValues);
+  double maxValue = lanes[scalarBlockMax(lanes, 2)];
+  for (; i < count; ++i) {
+    if (maxValue < pValues[i]) {
+      maxValue = pValues[i];
+    }
+  }
+  // With NaN in the block, the reduced value may not be found
+  std::size_t index = findDoubleSse2(pValues, count, maxValue);
+  return index < count ? index : scalarBlockMax(pValues, count);
+}
+
+__attribute__((target("avx2")))
+std::size_t findDoubleAvx2(const double *pValues, std::size_t count, const double &value)
+{
+  const __m256d needle = _mm256_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(pValues + i), needle,
+      _CMP_EQ_OQ));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + scalarBlockFind(pValues + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+std::size_t countDoubleAvx2(const double *pValues, std::size_t count, const double &value)
+{
+  const __m256d needle = _mm256_set1_pd(value);
+  std::size_t equalCount = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    equalCount += __builtin_popcount(
+      _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(pValues + i), needle, _CMP_EQ_OQ)));
+  }
+  return equalCount + scalarBlockCount(pValues + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+std::size_t minDoubleAvx2(const double *pValues, std::size_t count)
+{
+  if (count < 4) {
+    return scalarBlockMin(pValues, count);
+  }
+
+  __m256d minValues = _mm256_loadu_pd(pValues);
+  std::size_t i = 4;
+  for (; i + 4 <= count; i += 4) {
+    minValues = _mm256_min_pd(minValues, _mm256_loadu_pd(pValues + i));
+  }
+
+  double lanes[4];
+  _mm256_storeu_pd(lanes, minValues);
+  double minValue = lanes[scalarBlockMin(lanes, 4)];
+  for (; i < count; ++i) {
+    if (pValues[i] < minValue) {
+      minValue = pValues[i];
+    }
+  }
+  // With NaN in the block, the reduced value may not be found
+  std::size_t index = findDoubleAvx2(pValues, count, minValue);
+  return index < count ? index : scalarBlockMin(pValues, count);
+}
+
+__attribute__((target("avx2")))
+std::size_t maxDoubleAvx2(const double *pValues, std::size_t count)
+{
+  if (count < 4) {
+    return scalarBlockMax(pValues, count);
+  }
+
+  __m256d maxValues = _mm256_loadu_pd(pValues);
+  std::size_t i = 4;
+  for (; i + 4 <= count; i += 4) {
+    maxValues = _mm256_max_pd(maxValues, _mm256_loadu_pd(pValues + i));
+  }
+
+  double lanes[4];
+  _mm256_storeu_pd(lanes, maxValues);
+  double maxValue = lanes[scalarBlockMax(lanes, 4)];
+  for (; i < count; ++i) {
+    if (maxValue < pValues[i]) {
+      maxValue = pValues[i];
+    }
+  }
+  // With NaN in the block, the reduced value may not be found
+  std::size_t index = findDoubleAvx2(pValues, count, maxValue);
+  return index < count ? index : scalarBlockMax(pValues, count);
+}
+
+bool hasAvx2()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+BlockKernels<int> selectIntKernels()
+{
+  if (hasAvx2()) {
+    BlockKernels<int> kernels = { findIntAvx2, countIntAvx2, minIntAvx2, maxIntAvx2 };
+    return kernels;
+  }
+  BlockKernels<int> kernels = { findIntSse2, countIntSse2, minIntSse2, maxIntSse2 };
+  return kernels;
+}
+
+BlockKernels<double> selectDoubleKernels()
+{
+  if (hasAvx2()) {
+    BlockKernels<double> kernels = {
+      findDoubleAvx2, countDoubleAvx2, minDoubleAvx2, maxDoubleAvx2
+    };
+    return kernels;
+  }
+  BlockKernels<double> kernels = {
+    findDoubleSse2, countDoubleSse2, minDoubleSse2, maxDoubleSse2
+  };
+  return kernels;
+}
+
+#else
+
+BlockKernels<int> selectIntKernels()
+{
+  BlockKernels<int> kernels = {
+    scalarBlockFind<int>, scalarBlockCount<int>, scalarBlockMin<int>, scalarBlockMax<int>
+  };
+  return kernels;
+}
+
+BlockKernels<double> selectDoubleKernels()
+{
+  BlockKernels<double> kernels = {
+    scalarBlockFind<double>, scalarBlockCount<double>, scalarBlockMin<double>,
+    scalarBlockMax<double>
+  };
+  return kernels;
+}
+
+#endif
+
+/**
+ * Kernels are selected once, by the first search
+ */
+const BlockKernels<int> &intKernels()
+{
+  static const BlockKernels<int> kernels = selectIntKernels();
+  return kernels;
+}
+
+const BlockKernels<double> &doubleKernels()
+{
+  static const BlockKernels<double> kernels = selectDoubleKernels();
+  return kernels;
+}
+
+}
+
+template<>
+std::size_t blockFind<int>(const int *pValues, std::size_t count, const int &value)
+{
+  return intKernels().m_find(pValues, count, value);
+}
+
+template<>
+std::size_t blockCount<int>(const int *pValues, std::size_t count, const int &value)
+{
+  return intKernels().m_count(pValues, count, value);
+}
+
+template<>
+std::size_t blockMin<int>(const int *pValues, std::size_t count)
+{
+  return intKernels().m_min(pValues, count);
+}
+
+template<>
+std::size_t blockMax<int>(const int *pValues, std::size_t count)
+{
+  return intKernels().m_max(pValues, count);
+}
+
+template<>
+std::size_t blockFind<double>(const double *pValues, std::size_t count, const double &value)
+{
+  return doubleKernels().m_find(pValues, count, value);
+}
+
+template<>
+std::size_t blockCount<double>(const double *pValues, std::size_t count, const double &value)
+{
+  return doubleKernels().m_count(pValues, count, value);
+}
+
+template<>
+std::size_t blockMin<double>(const double *pValues, std::size_t count)
+{
+  return doubleKernels().m_min(pValues, count);
+}
+
+template<>
+std::size_t blockMax<double>(const double *pValues, std::size_t count)
+{
+  return doubleKernels().m_max(pValues, count);
+}
@@ -0,0 +1,118 @@
+/**
+ * Search kernels over blocks of contiguous values, for lists whose nodes store several values
+ *   - blockFind, blockCount, blockMin and blockMax compare values with == and <, one at a time,
+ *     as the scalarBlock functions do
+ *   - for int and double, they compare whole vectors at once: With AVX2 where the processor
+ *     supports it (checked once, at run time), otherwise with SSE2, which every x86-64 processor
+ *     has. Other processors and compilers use the scalar loops. Define BLOCKSEARCH_SIMD to 0 to
+ *     use the scalar loops everywhere, for comparison
+ *   - min and max of floating-point values are unspecified if the block contains NaN
+ */
+
+#ifndef BLOCKSEARCH_H
+#define BLOCKSEARCH_H
+
+#include <cstddef>
+
+/**
+ * Return the index of the first value equal to value, or count if there is none
+ */
+template<class T>
+std::size_t scalarBlockFind(const T *pValues, std::size_t count, const T &value)
+{
+  std::size_t i = 0;
+  while (i < count && ! (pValues[i] == value)) {
+    ++i;
+  }
+  return i;
+}
+
+/**
+ * Return the number of values equal to value
+ */
+template<class T>
+std::size_t scalarBlockCount(const T *pValues, std::size_t count, const T &value)
+{
+  std::size_t equalCount = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (pValues[i] == value) {
+      ++equalCount;
+    }
+  }
+  return equalCount;
+}
+
+/**
+ * Return the index of the first smallest value. The block must not be empty
+ */
+template<class T>
+std::size_t scalarBlockMin(const T *pValues, std::size_t count)
+{
+  std::size_t minIndex = 0;
+  for (std::size_t i = 1; i < count; ++i) {
+    if (pValues[i] < pValues[minIndex]) {
+      minIndex = i;
+    }
+  }
+  return minIndex;
+}
+
+/**
+ * Return the index of the first largest value. The block must not be empty
+ */
+template<class T>
+std::size_t scalarBlockMax(const T *pValues, std::size_t count)
+{
+  std::size_t maxIndex = 0;
+  for (std::size_t i = 1; i < count; ++i) {
+    if (pValues[maxIndex] < pValues[i]) {
+      maxIndex = i;
+    }
+  }
+  return maxIndex;
+}
+
+template<class T>
+std::size_t blockFind(const T *pValues, std::size_t count, const T &value)
+{
+  return scalarBlockFind(pValues, count, value);
+}
+
+template<class T>
+std::size_t blockCount(const T *pValues, std::size_t count, const T &value)
+{
+  return scalarBlockCount(pValues, count, value);
+}
+
+template<class T>
+std::size_t blockMin(const T *pValues, std::size_t count)
+{
+  return scalarBlockMin(pValues, count);
+}
+
+template<class T>
+std::size_t blockMax(const T *pValues, std::size_t count)
+{
+  return scalarBlockMax(pValues, count);
+}
+
+// Vector kernels, defined in BlockSearch.cpp
+template<>
+std::size_t blockFind<int>(const int *pValues, std::size_t count, const int &value);
+template<>
+std::size_t blockCount<int>(const int *pValues, std::size_t count, const int &value);
+template<>
+std::size_t blockMin<int>(const int *pValues, std::size_t count);
+template<>
+std::size_t blockMax<int>(const int *pValues, std::size_t count);
+
+template<>
+std::size_t blockFind<double>(const double *pValues, std::size_t count, const double &value);
+template<>
+std::size_t blockCount<double>(const double *pValues, std::size_t count, const double &value);
+template<>
+std::size_t blockMin<double>(const double *pValues, std::size_t count);
+template<>
+std::size_t blockMax<double>(const double *pValues, std::size_t count);
+
+#endif
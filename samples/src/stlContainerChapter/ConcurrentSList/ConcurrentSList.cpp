@@ -0,0 +1,120 @@
+#include "ConcurrentSList.h"
+
+#include <utility>
+
+struct ConcurrentSList::Node {
+  explicit Node(const std::string &value);
+
+  std::string m_value;
+  // Atomic since a thread which lost the race for a node may still read its link while the
+  // winner reuses it to chain the node for deletion
+  std::atomic<Node *> m_pNextNode;
+};
+
+ConcurrentSList::Node::Node(const std::string &value)
+: m_value(value),
+  m_pNextNode(0)
+{}
+
+ConcurrentSList::ConcurrentSList()
+: m_pFirstNode(0),
+  m_popCount(0),
+  m_pFirstPendingNode(0)
+{}
+
+/**
+ * Must not be called while other threads are still accessing the list
+ */
+ConcurrentSList::~ConcurrentSList()
+{
+  deleteNodes(m_pFirstNode.load());
+  deleteNodes(m_pFirstPendingNode.load());
+}
+
+void ConcurrentSList::push_front(const std::string &value)
+{
+  Node *pNode = new Node(value);
+  Node *pFirstNode = m_pFirstNode.load(std::memory_order_relaxed);
+  do {
+    pNode->m_pNextNode.store(pFirstNode, std::memory_order_relaxed);
+  } while (! m_pFirstNode.compare_exchange_weak(pFirstNode, pNode, std::memory_order_release,
+    std::memory_order_relaxed));
+}
+
+/**
+ * Remove the first element and return it through value. Return false if the list was empty
+ */
+bool ConcurrentSList::pop_front(std::string &value)
+{
+  // Announce the pop before reading the head, so that the node we read cannot be deleted
+  ++m_popCount;
+
+  Node *pFirstNode = m_pFirstNode.load();
+  while (pFirstNode && ! m_pFirstNode.compare_exchange_weak(pFirstNode,
+    pFirstNode->m_pNextNode.load(std::memory_order_relaxed))) {}
+
+  if (! pFirstNode) {
+    --m_popCount;
+    return false;
+  }
+
+  // The node now belongs to this thread only
+  value = std::move(pFirstNode->m_value);
+  tryReclaim(pFirstNode);
+  return true;
+}
+
+bool ConcurrentSList::empty() const
+{
+  return m_pFirstNode.load() == 0;
+}
+
+/**
+ * Delete a popped node if no other thread is popping, otherwise defer its deletion. Decrements
+ * the pop count
+ */
+void ConcurrentSList::tryReclaim(Node *pNode)
+{
+  if (m_popCount == 1) {
+    // Alone: Claim the pending nodes, and delete them if still alone afterwards
+    Node *pPendingNodes = m_pFirstPendingNode.exchange(0);
+    if (--m_popCount == 0) {
+      deleteNodes(pPendingNodes);
+    }
+    else if (pPendingNodes) {
+      chainPendingNodes(pPendingNodes);
+    }
+    // No other thread can reach our own node anymore, even if one started popping meanwhile
+    delete pNode;
+  }
+  else {
+    chainPendingNodes(pNode, pNode);
+    --m_popCount;
+  }
+}
+
+void ConcurrentSList::chainPendingNodes(Node *pFirstNode)
+{
+  Node *pLastNode = pFirstNode;
+  while (Node *pNextNode = pLastNode->m_pNextNode.load(std::memory_order_relaxed)) {
+    pLastNode = pNextNode;
+  }
+  chainPendingNodes(pFirstNode, pLastNode);
+}
+
+void ConcurrentSList::chainPendingNodes(Node *pFirstNode, Node *pLastNode)
+{
+  Node *pFirstPendingNode = m_pFirstPendingNode.load();
+  do {
+    pLastNode->m_pNextNode.store(pFirstPendingNode, std::memory_order_relaxed);
+  } while (! m_pFirstPendingNode.compare_exchange_weak(pFirstPendingNode, pFirstNode));
+}
+
+void ConcurrentSList::deleteNodes(Node *pNode)
+{
+  while (pNode) {
+    Node *pNextNode = pNode->m_pNextNode.load(std::memory_order_relaxed);
+    delete pNode;
+    pNode = pNextNode;
+  }
+}
@@ -0,0 +1,49 @@
+/**
+ * Implementation of a list holding standard strings, which can be shared between threads
+ *   - only std::string objects are stored
+ *   - the list is used as a stack (Treiber stack): push_front and pop_front are lock-free
+ *   - popped nodes are only deleted at a moment when no other thread is executing pop_front.
+ *     This makes memory reclamation safe, and since a node address cannot be reused while a
+ *     popping thread may still hold it, it also rules out the ABA problem. Under sustained
+ *     contention, nodes can pile up until pop_front calls stop overlapping
+ *   - no iterators: Elements are only accessible by popping them
+ */
+
+#ifndef CONCURRENTSLIST_H
+#define CONCURRENTSLIST_H
+
+#include <atomic>
+#include <string>
+
+class ConcurrentSList {
+public:
+  ConcurrentSList();
+  ~ConcurrentSList();
+
+  void push_front(const std::string &value);
+  bool pop_front(std::string &value);
+
+  bool empty() const;
+
+private:
+  struct Node;
+
+  // Not copyable
+  ConcurrentSList(const ConcurrentSList &rhs);
+  ConcurrentSList &operator=(const ConcurrentSList &rhs);
+
+  void tryReclaim(Node *pNode);
+  void chainPendingNodes(Node *pFirstNode);
+  void chainPendingNodes(Node *pFirstNode, Node *pLastNode);
+
+  static void deleteNodes(Node *pNode);
+
+  std::atomic<Node *> m_pFirstNode;
+
+  // Number of threads currently executing pop_front
+  std::atomic<unsigned> m_popCount;
+  // Popped nodes waiting to be deleted
+  std::atomic<Node *> m_pFirstPendingNode;
+};
+
+#endif
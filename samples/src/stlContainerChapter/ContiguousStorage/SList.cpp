@@ -0,0 +1,31 @@
+#include "SList.h"
+
+#include <cassert>
+
+/**
+ * Amortized constant time: The buffer grows geometrically
+ */
+void SList::push_front(const std::string &value)
+{
+  m_values.push_back(value);
+}
+
+/**
+ * Function factoring out the code for creating a list from an existing one. Must
+ * be called only on an empty list. The buffer is copied in one go, already in the right order
+ */
+void SList::createFrom(const SList &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_values.empty());
+
+  m_values = rhs.m_values;
+}
+
+/**
+ * Function factoring out the cleanup code. The buffer is kept, for reuse by assignment
+ */
+void SList::release()
+{
+  m_values.clear();
+}
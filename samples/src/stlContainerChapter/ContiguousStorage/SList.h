@@ -0,0 +1,241 @@
+/**
+ * Implementation of a list holding standard strings
+ *   - only std::string objects are stored
+ *   - same interface as the node-based lists, but no nodes: Since Node is hidden behind the
+ *     iterators, the elements can as well be stored contiguously, in a growable buffer. They are
+ *     kept in reverse order of insertion, so that push_front appends to the buffer in amortized
+ *     constant time, and traversals walk the buffer backwards, at the speed of an array scan
+ *   - an iterator refers to its list and to a position counted from the back of the list, so that
+ *     it remains valid when elements are pushed at the front, as with nodes. Pointers and
+ *     references to the elements, however, are invalidated when the buffer grows
+ */
+
+#ifndef SLIST_H
+#define SLIST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class SList {
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const std::string *operator->() const;
+    const std::string &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs);
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs);
+
+  private:
+    friend class SList;
+
+    ConstIterator(const SList *pList, std::size_t position);
+
+    const SList *m_pList;
+    // Number of elements from the iterator position to the end of the list, 0 for end()
+    std::size_t m_position;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    std::string *operator->() const;
+    std::string &operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs);
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs);
+  
+  private:
+    friend class SList;
+    friend class ConstIterator;
+
+    Iterator(SList *pList, std::size_t position);
+
+    SList *m_pList;
+    std::size_t m_position;
+  };
+
+  SList();
+  explicit SList(std::size_t capacity);
+  
+  SList(const SList &rhs);
+  SList &operator=(const SList &rhs);
+
+  ~SList();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(const std::string &value);
+
+private:
+  void createFrom(const SList &rhs);
+  void release();
+
+  // Elements in reverse order: The first element of the list is the last one of the buffer
+  std::vector<std::string> m_values;
+};
+
+inline SList::ConstIterator::ConstIterator()
+: m_pList(0),
+  m_position(0)
+{}
+
+inline SList::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pList(rhs.m_pList),
+  m_position(rhs.m_position)
+{}
+
+inline SList::ConstIterator &SList::ConstIterator::operator++()
+{
+  --m_position;
+  return *this;
+}
+
+inline const SList::ConstIterator SList::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  --m_position;
+  return tmp;
+}
+
+inline const std::string *SList::ConstIterator::operator->() const
+{
+  return &m_pList->m_values[m_position - 1];
+}
+
+inline const std::string &SList::ConstIterator::operator*() const
+{
+  return m_pList->m_values[m_position - 1];
+}
+
+/**
+ * Only positions are compared: As with nodes, end() and default-constructed iterators are equal
+ */
+inline bool operator==(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_position == rhs.m_position;
+}
+
+inline bool operator!=(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_position != rhs.m_position;
+}
+
+inline SList::ConstIterator::ConstIterator(const SList *pList, std::size_t position)
+: m_pList(pList),
+  m_position(position)
+{}
+
+inline SList::Iterator::Iterator()
+: m_pList(0),
+  m_position(0)
+{}
+
+inline SList::Iterator &SList::Iterator::operator++()
+{
+  --m_position;
+  return *this;
+}
+
+inline const SList::Iterator SList::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  --m_position;
+  return tmp;
+}
+
+inline std::string *SList::Iterator::operator->() const
+{
+  return &m_pList->m_values[m_position - 1];
+}
+
+inline std::string &SList::Iterator::operator*() const
+{
+  return m_pList->m_values[m_position - 1];
+}
+
+inline bool operator==(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_position == rhs.m_position;
+}
+
+inline bool operator!=(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_position != rhs.m_position;
+}
+
+inline SList::Iterator::Iterator(SList *pList, std::size_t position)
+: m_pList(pList),
+  m_position(position)
+{}
+
+inline SList::SList()
+{}
+
+/**
+ * Takes the place of the chunk size of pooled node-based lists: Room for capacity elements is
+ * reserved up front
+ */
+inline SList::SList(std::size_t capacity)
+{
+  m_values.reserve(capacity);
+}
+
+inline SList::SList(const SList &rhs)
+{
+  createFrom(rhs);
+}
+
+inline SList &SList::operator=(const SList &rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    createFrom(rhs);
+  }
+  return *this;
+}
+
+inline SList::~SList()
+{
+  release();
+}
+
+inline SList::ConstIterator SList::begin() const
+{
+  return ConstIterator(this, m_values.size());
+}
+
+inline SList::Iterator SList::begin()
+{
+  return Iterator(this, m_values.size());
+}
+
+inline SList::ConstIterator SList::end() const
+{
+  return ConstIterator(this, 0);
+}
+
+inline SList::Iterator SList::end()
+{
+  return Iterator(this, 0);
+}
+
+#endif
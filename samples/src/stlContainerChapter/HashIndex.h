@@ -0,0 +1,267 @@
+/**
+ * Hash index for membership tests and lookups in a chain of nodes linked through m_pNextNode
+ *   - an open-addressing table (linear probing) of node pointers, keyed by the hash of the node
+ *     values. The hash is stored along with the pointer, so that probes only compare values whose
+ *     hashes match, and growing the table does not hash the values again
+ *   - every node is indexed, duplicates included. find() returns one of the nodes holding the
+ *     value, not necessarily the first one of the chain
+ *   - the index is built by build(), in one linear pass, and then kept up to date node by node by
+ *     the list: inserted() and erased() cost O(1) on average. Running out of memory while building
+ *     or growing it invalidates it, until the list builds it again. Lookups never modify it, so
+ *     that they may run concurrently. Values must not be modified in place while they are indexed
+ *   - erasure shifts the following entries back rather than leaving tombstones, so that the table
+ *     never degrades after many insertions and erasures
+ *   - memory: each slot holds a hash and a pointer (16 bytes on 64-bit platforms). The table has
+ *     a power of 2 number of slots and grows when it is 3/4 full, so an index costs between
+ *     21 and 43 bytes per element (memoryUsage() tells)
+ */
+
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+template<class Node, class Hash>
+class HashIndex {
+public:
+  HashIndex();
+
+  bool isBuilt() const;
+  std::size_t size() const;
+  std::size_t memoryUsage() const;
+
+  void build(Node *pFirstNode);
+  void reserve(std::size_t size);
+  void inserted(Node *pNode);
+  void erased(const Node *pNode);
+  void invalidate();
+
+  template<class Value>
+  Node *find(const Value &value) const;
+
+private:
+  struct Slot {
+    std::size_t m_hash;
+    // Null if the slot is free
+    Node *m_pNode;
+  };
+
+  // Not copyable
+  HashIndex(const HashIndex &rhs);
+  HashIndex &operator=(const HashIndex &rhs);
+
+  void resize(std::size_t slotCount);
+  void insert(std::size_t hash, Node *pNode);
+
+  static std::size_t slotCountFor(std::size_t size);
+
+  bool m_isBuilt;
+  std::size_t m_size;
+  std::vector<Slot> m_slots;
+};
+
+// Smallest table allocated
+const std::size_t s_minHashIndexSlotCount = 16;
+
+template<class Node, class Hash>
+HashIndex<Node, Hash>::HashIndex()
+: m_isBuilt(false),
+  m_size(0)
+{}
+
+template<class Node, class Hash>
+bool HashIndex<Node, Hash>::isBuilt() const
+{
+  return m_isBuilt;
+}
+
+/**
+ * Number of nodes indexed. Only meaningful while the index is built
+ */
+template<class Node, class Hash>
+std::size_t HashIndex<Node, Hash>::size() const
+{
+  return m_size;
+}
+
+/**
+ * Bytes allocated by the table, 0 until it is first built
+ */
+template<class Node, class Hash>
+std::size_t HashIndex<Node, Hash>::memoryUsage() const
+{
+  return m_slots.capacity() * sizeof(Slot);
+}
+
+/**
+ * Build an empty index, large enough for size nodes to be inserted without growing. Used when
+ * all nodes of a chain are about to be inserted, as when a list is copied. If memory runs out,
+ * the index is invalidated instead
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::reserve(std::size_t size)
+{
+  try {
+    m_slots.clear();
+    m_slots.resize(slotCountFor(size));
+    m_size = 0;
+    m_isBuilt = true;
+  }
+  catch (...) {
+    invalidate();
+  }
+}
+
+/**
+ * Keep the index up to date after pNode was linked into the chain. If memory runs out, the index
+ * is invalidated instead
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::inserted(Node *pNode)
+{
+  if (! m_isBuilt) {
+    return;
+  }
+
+  try {
+    if ((m_size + 1) * 4 > m_slots.size() * 3) {
+      resize(m_slots.size() * 2);
+    }
+    insert(Hash()(pNode->m_value), pNode);
+  }
+  catch (...) {
+    invalidate();
+  }
+}
+
+/**
+ * Keep the index up to date before pNode, which must be indexed, is unlinked and destroyed. The
+ * entries following it in its cluster are shifted back to fill its slot
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::erased(const Node *pNode)
+{
+  if (! m_isBuilt) {
+    return;
+  }
+
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t hole = Hash()(pNode->m_value) & mask;
+  while (m_slots[hole].m_pNode != pNode) {
+    assert(m_slots[hole].m_pNode != 0);
+    hole = (hole + 1) & mask;
+  }
+
+  // An entry may move to the hole if the hole lies between its home slot and its current slot
+  for (std::size_t slot = (hole + 1) & mask; m_slots[slot].m_pNode; slot = (slot + 1) & mask) {
+    std::size_t home = m_slots[slot].m_hash & mask;
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      m_slots[hole] = m_slots[slot];
+      hole = slot;
+    }
+  }
+  m_slots[hole].m_pNode = 0;
+  --m_size;
+}
+
+/**
+ * Forget all entries. The table is kept, to be reused when the index is rebuilt
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::invalidate()
+{
+  if (m_isBuilt) {
+    m_isBuilt = false;
+    m_size = 0;
+    m_slots.clear();
+  }
+}
+
+/**
+ * Return an indexed node whose value is equal to value, or null if there is none. The index must
+ * be built
+ */
+template<class Node, class Hash>
+template<class Value>
+Node *HashIndex<Node, Hash>::find(const Value &value) const
+{
+  assert(m_isBuilt);
+
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t hash = Hash()(value);
+  for (std::size_t slot = hash & mask; m_slots[slot].m_pNode; slot = (slot + 1) & mask) {
+    if (m_slots[slot].m_hash == hash && m_slots[slot].m_pNode->m_value == value) {
+      return m_slots[slot].m_pNode;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Index all nodes of the chain starting at pFirstNode, forgetting former entries. If memory runs
+ * out, the index is invalidated instead
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::build(Node *pFirstNode)
+{
+  std::size_t size = 0;
+  for (const Node *pNode = pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    ++size;
+  }
+
+  reserve(size);
+  if (m_isBuilt) {
+    for (Node *pNode = pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+      insert(Hash()(pNode->m_value), pNode);
+    }
+  }
+}
+
+/**
+ * Move the entries to a table of slotCount slots. Stored hashes are reused
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::resize(std::size_t slotCount)
+{
+  std::vector<Slot> slots(slotCount);
+  m_slots.swap(slots);
+  m_size = 0;
+  for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+    if (slots[slot].m_pNode) {
+      insert(slots[slot].m_hash, slots[slot].m_pNode);
+    }
+  }
+}
+
+/**
+ * Store an entry in the first free slot from its home slot. The table must not be full
+ */
+template<class Node, class Hash>
+void HashIndex<Node, Hash>::insert(std::size_t hash, Node *pNode)
+{
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t slot = hash & mask;
+  while (m_slots[slot].m_pNode) {
+    slot = (slot + 1) & mask;
+  }
+  m_slots[slot].m_hash = hash;
+  m_slots[slot].m_pNode = pNode;
+  ++m_size;
+}
+
+/**
+ * Number of slots for size entries: The smallest power of 2 which keeps the table at most 3/4 full
+ */
+template<class Node, class Hash>
+std::size_t HashIndex<Node, Hash>::slotCountFor(std::size_t size)
+{
+  std::size_t slotCount = s_minHashIndexSlotCount;
+  while (size * 4 > slotCount * 3) {
+    slotCount *= 2;
+  }
+  return slotCount;
+}
+
+#endif
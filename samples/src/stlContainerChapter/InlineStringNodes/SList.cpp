@@ -0,0 +1,58 @@
+#include "SList.h"
+
+#include <cassert>
+#include <cstring>
+#include <new>
+
+/**
+ * Allocate a node together with the storage for the characters of its value
+ */
+SList::Node *SList::createNode(std::string_view value, Node *pNextNode)
+{
+  Node *pNode = new (::operator new(sizeof(Node) + value.size())) Node;
+  pNode->m_pNextNode = pNextNode;
+  pNode->m_length = value.size();
+  // The data of an empty string_view may be null, which memcpy does not accept
+  if (value.size()) {
+    std::memcpy(pNode->data(), value.data(), value.size());
+  }
+  return pNode;
+}
+
+/**
+ * Nodes are trivially destructible, only their storage needs to be released
+ */
+void SList::destroyNode(Node *pNode)
+{
+  ::operator delete(pNode);
+}
+
+/**
+ * Function factoring out the code for creating a list from an existing one. Must
+ * be called only on an empty list
+ */
+void SList::createFrom(const SList &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_pFirstNode == 0);
+
+  Node **ppNextNode = &m_pFirstNode;
+  for (const Node *pRhsNode = rhs.m_pFirstNode; pRhsNode; pRhsNode = pRhsNode->m_pNextNode) {
+    *ppNextNode = createNode(std::string_view(pRhsNode->data(), pRhsNode->m_length), 0);
+    ppNextNode = &(*ppNextNode)->m_pNextNode;
+  }
+}
+
+/**
+ * Function factoring out the cleanup code
+ */
+void SList::release()
+{
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pNextNode = pNode->m_pNextNode;
+    destroyNode(pNode);
+    pNode = pNextNode;
+  }
+  m_pFirstNode = 0;
+}
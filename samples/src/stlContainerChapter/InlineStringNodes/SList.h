@@ -0,0 +1,267 @@
+/**
+ * Implementation of a list holding strings
+ *   - strings are stored inline: Their characters follow the node header in the same
+ *     allocation, sized for each string. Traversal therefore touches a single memory block per
+ *     element, and each element costs a single allocation
+ *   - values are exposed as std::string_view. Since the node size depends on the string length,
+ *     values cannot be modified in place, not even through Iterator
+ *   - inlining is performed. We allow the Node structure definition to be revealed
+ */
+
+#ifndef SLIST_H
+#define SLIST_H
+
+#include <cstddef>
+#include <string_view>
+
+class SList {
+private:
+  struct Node {
+    const char *data() const;
+    char *data();
+
+    Node *m_pNextNode;
+    std::size_t m_length;
+    // The characters (not null-terminated) are stored right after the node
+  };
+
+  // Since values are not stored as objects, operator-> returns this proxy
+  class ValuePointer {
+  public:
+    explicit ValuePointer(std::string_view value);
+
+    const std::string_view *operator->() const;
+
+  private:
+    std::string_view m_value;
+  };
+
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    ValuePointer operator->() const;
+    std::string_view operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs);
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs);
+
+  private:
+    friend class SList;
+
+    explicit ConstIterator(const Node *);
+
+    const Node *m_pNode;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    ValuePointer operator->() const;
+    std::string_view operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs);
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs);
+  
+  private:
+    friend class SList;
+    friend class ConstIterator;
+
+    explicit Iterator(Node *pNode);
+
+    Node *m_pNode;
+  };
+
+  SList();
+  
+  SList(const SList &rhs);
+  SList &operator=(const SList &rhs);
+
+  ~SList();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(std::string_view value);
+
+private:
+  static Node *createNode(std::string_view value, Node *pNextNode);
+  static void destroyNode(Node *pNode);
+
+  void createFrom(const SList &rhs);
+  void release();
+
+  Node *m_pFirstNode;
+};
+
+inline const char *SList::Node::data() const
+{
+  return reinterpret_cast<const char *>(this + 1);
+}
+
+inline char *SList::Node::data()
+{
+  return reinterpret_cast<char *>(this + 1);
+}
+
+inline SList::ValuePointer::ValuePointer(std::string_view value)
+: m_value(value)
+{}
+
+inline const std::string_view *SList::ValuePointer::operator->() const
+{
+  return &m_value;
+}
+
+inline SList::ConstIterator::ConstIterator()
+: m_pNode(0)
+{}
+
+inline SList::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pNode(rhs.m_pNode)
+{}
+
+inline SList::ConstIterator &SList::ConstIterator::operator++()
+{
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+inline const SList::ConstIterator SList::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  m_pNode = m_pNode->m_pNextNode;
+  return tmp;
+}
+
+inline SList::ValuePointer SList::ConstIterator::operator->() const
+{
+  return ValuePointer(**this);
+}
+
+inline std::string_view SList::ConstIterator::operator*() const
+{
+  return std::string_view(m_pNode->data(), m_pNode->m_length);
+}
+
+inline bool operator==(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_pNode == rhs.m_pNode;
+}
+
+inline bool operator!=(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_pNode != rhs.m_pNode;
+}
+
+inline SList::ConstIterator::ConstIterator(const Node *pNode)
+: m_pNode(pNode)
+{}
+
+inline SList::Iterator::Iterator()
+: m_pNode(0)
+{}
+
+inline SList::Iterator &SList::Iterator::operator++()
+{
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+inline const SList::Iterator SList::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  m_pNode = m_pNode->m_pNextNode;
+  return tmp;
+}
+
+inline SList::ValuePointer SList::Iterator::operator->() const
+{
+  return ValuePointer(**this);
+}
+
+inline std::string_view SList::Iterator::operator*() const
+{
+  return std::string_view(m_pNode->data(), m_pNode->m_length);
+}
+
+inline bool operator==(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_pNode == rhs.m_pNode;
+}
+
+inline bool operator!=(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_pNode != rhs.m_pNode;
+}
+
+inline SList::Iterator::Iterator(Node *pNode)
+: m_pNode(pNode)
+{}
+
+inline SList::SList()
+: m_pFirstNode(0)
+{}
+
+inline SList::SList(const SList &rhs)
+: m_pFirstNode(0)
+{
+  createFrom(rhs);
+}
+
+inline SList &SList::operator=(const SList &rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    createFrom(rhs);
+  }
+  return *this;
+}
+
+inline SList::~SList()
+{
+  release();
+}
+
+inline SList::ConstIterator SList::begin() const
+{
+  return ConstIterator(m_pFirstNode);
+}
+
+inline SList::Iterator SList::begin()
+{
+  return Iterator(m_pFirstNode);
+}
+
+inline SList::ConstIterator SList::end() const
+{
+  return ConstIterator(0);
+}
+
+inline SList::Iterator SList::end()
+{
+  return Iterator(0);
+}
+
+inline void SList::push_front(std::string_view value)
+{
+  Node *pNode = createNode(value, m_pFirstNode);
+  m_pFirstNode = pNode;
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "SList.h"
 
 #include <cassert>
+#include <new>
 
 struct SList::Node {
   Node(const std::string &value, Node *pNextNode);
@@ -62,10 +63,29 @@ std::string &SList::Iterator::operator*() const
 
 void SList::push_front(const std::string &value)
 {
-  Node *pNode = new Node(value, m_pFirstNode);
+  Node *pNode = createNode(value, m_pFirstNode);
   m_pFirstNode = pNode;
 }
 
+/**
+ * Create a node, drawing its storage from the pool if the list has one
+ */
+SList::Node *SList::createNode(const std::string &value, Node *pNextNode)
+{
+  if (! m_pNodePool) {
+    return new Node(value, pNextNode);
+  }
+
+  void *pStorage = m_pNodePool->allocate();
+  try {
+    return new (pStorage) Node(value, pNextNode);
+  }
+  catch (...) {
+    m_pNodePool->deallocate(pStorage);
+    throw;
+  }
+}
+
 /**
  * Function factoring out the code for creating a list from an existing one. Must
  * be called only on an empty list
@@ -80,28 +100,48 @@ void SList::createFrom(const SList &rhs)
   while (pRhsNode) {
     // Empty list; create first node
     if (! m_pFirstNode) {
-      m_pFirstNode = new Node(pRhsNode->m_value, 0);
+      m_pFirstNode = createNode(pRhsNode->m_value, 0);
       pNode = m_pFirstNode;
     }
     // Add following nodes
     else {
-      pNode->m_pNextNode = new Node(pRhsNode->m_value, 0);
+      pNode->m_pNextNode = createNode(pRhsNode->m_value, 0);
       pNode = pNode->m_pNextNode;
     }
     pRhsNode = pRhsNode->m_pNextNode;
   }
 }
 
+/**
+ * Create the pool from which the nodes of a pooled list are drawn
+ */
+NodePool *SList::createNodePool(std::size_t nodesPerChunk)
+{
+  return new NodePool(sizeof(Node), nodesPerChunk);
+}
+
 /**
  * Function factoring out the cleanup code
  */
 void SList::release()
 {
   Node *pNode = m_pFirstNode;
-  while (pNode) {
-    Node *pNextNode = pNode->m_pNextNode;
-    delete pNode;
-    pNode = pNextNode;
+  if (m_pNodePool) {
+    // Only destroy the values. The storage is given back to the global heap in bulk, one chunk
+    // at a time
+    while (pNode) {
+      Node *pNextNode = pNode->m_pNextNode;
+      pNode->~Node();
+      pNode = pNextNode;
+    }
+    m_pNodePool->release();
+  }
+  else {
+    while (pNode) {
+      Node *pNextNode = pNode->m_pNextNode;
+      delete pNode;
+      pNode = pNextNode;
+    }
   }
   m_pFirstNode = 0;
 }
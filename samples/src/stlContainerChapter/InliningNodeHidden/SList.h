@@ -8,6 +8,8 @@
 #ifndef SLIST_H
 #define SLIST_H
 
+#include "NodePool.h"
+
 #include <string>
 
 class SList {
@@ -62,6 +64,7 @@ public:
   };
 
   SList();
+  explicit SList(std::size_t nodesPerChunk);
   
   SList(const SList &rhs);
   SList &operator=(const SList &rhs);
@@ -77,10 +80,16 @@ public:
   void push_front(const std::string &value);
 
 private:
+  static NodePool *createNodePool(std::size_t nodesPerChunk);
+
   void createFrom(const SList &rhs);
   void release();
 
+  Node *createNode(const std::string &value, Node *pNextNode);
+
   Node *m_pFirstNode;
+  // Null if nodes are allocated on the global heap
+  NodePool *m_pNodePool;
 };
 
 inline SList::ConstIterator::ConstIterator()
@@ -124,11 +133,18 @@ inline SList::Iterator::Iterator(Node *pNode)
 {}
 
 inline SList::SList()
-: m_pFirstNode(0)
+: m_pFirstNode(0),
+  m_pNodePool(0)
+{}
+
+inline SList::SList(std::size_t nodesPerChunk)
+: m_pFirstNode(0),
+  m_pNodePool(createNodePool(nodesPerChunk))
 {}
 
 inline SList::SList(const SList &rhs)
-: m_pFirstNode(0)
+: m_pFirstNode(0),
+  m_pNodePool(rhs.m_pNodePool ? createNodePool(rhs.m_pNodePool->nodesPerChunk()) : 0)
 {
   createFrom(rhs);
 }
@@ -146,6 +162,7 @@ inline SList &SList::operator=(const SList &rhs)
 inline SList::~SList()
 {
   release();
+  delete m_pNodePool;
 }
 
 inline SList::ConstIterator SList::begin() const
@@ -1,31 +1,416 @@
 #include "SList.h"
 
+#include "Prefetch.h"
+
 #include <cassert>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
 
 /**
  * Function factoring out the code for creating a list from an existing one. Must
- * be called only on an empty list
+ * be called only on an empty list. The nodes of rhs are walked directly rather than through
+ * push_front(first, last), so that they can be prefetched
  */
 void SList::createFrom(const SList &rhs)
 {
   // Ensure that the list is empty
   assert(m_pFirstNode == 0);
 
-  Node *pRhsNode = rhs.m_pFirstNode;
-  Node *pNode = 0;
-  while (pRhsNode) {
-    // Empty list; create first node
-    if (! m_pFirstNode) {
-      m_pFirstNode = new Node(pRhsNode->m_value, 0);
-      pNode = m_pFirstNode;
+  Stopwatch stopwatch;
+  Node **ppNextNode = &m_pFirstNode;
+  const Node *pRhsNode = rhs.m_pFirstNode;
+  const Node *pAheadRhsNode = prefetchNodesAhead(pRhsNode);
+
+  // If the size of rhs is known from its hash index, the index of the copy is sized once, and
+  // filled as the nodes are created. Otherwise, it is built once the nodes are
+  NodeHashIndex *pHashIndex = hashIndex();
+  NodeHashIndex *pRhsHashIndex = rhs.hashIndex();
+  bool isHashIndexed = pHashIndex && pRhsHashIndex && pRhsHashIndex->isBuilt();
+  if (isHashIndexed) {
+    pHashIndex->reserve(pRhsHashIndex->size());
+  }
+  try {
+    while (pRhsNode) {
+      pAheadRhsNode = prefetchNextNode(pAheadRhsNode);
+      *ppNextNode = createNode(pRhsNode->m_value, 0);
+      if (isHashIndexed) {
+        pHashIndex->inserted(*ppNextNode);
+      }
+      ppNextNode = &(*ppNextNode)->m_pNextNode;
+      pRhsNode = pRhsNode->m_pNextNode;
+    }
+  }
+  catch (...) {
+    release();
+    throw;
+  }
+  if (! isHashIndexed) {
+    rebuildHashIndex();
+  }
+  copied(stopwatch);
+}
+
+/**
+ * Move all elements of other to the front of the list, in the same order. Nothing is allocated
+ * or copied, but other has to be walked to find its last node
+ */
+void SList::splice_front(SList &other)
+{
+  assert(canSpliceFrom(other));
+
+  if (&other == this || ! other.m_pFirstNode) {
+    return;
+  }
+
+  Node *pLastNode = other.m_pFirstNode;
+  std::size_t count = 1;
+  for (; pLastNode->m_pNextNode; ++count) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  pLastNode->m_pNextNode = m_pFirstNode;
+  m_pFirstNode = other.m_pFirstNode;
+  other.m_pFirstNode = 0;
+  nodesMoved(other, count);
+
+  // The nodes were added at the front, so the skip index of the list remains valid. They are
+  // added to the hash index one by one, since they had to be walked anyway
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(m_pFirstNode, count);
+  }
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    for (Node *pNode = m_pFirstNode; pNode != pLastNode->m_pNextNode; pNode = pNode->m_pNextNode) {
+      pHashIndex->inserted(pNode);
+    }
+  }
+  other.invalidateSkipIndex();
+  other.rebuildHashIndex();
+}
+
+/**
+ * Move all elements of other after position, in the same order. Nothing is allocated or copied,
+ * but other has to be walked to find its last node
+ */
+void SList::splice_after(ConstIterator position, SList &other)
+{
+  assert(canSpliceFrom(other));
+  assert(&other != this);
+
+  if (! other.m_pFirstNode) {
+    return;
+  }
+
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pLastNode = other.m_pFirstNode;
+  while (pLastNode->m_pNextNode) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  pLastNode->m_pNextNode = pPositionNode->m_pNextNode;
+  pPositionNode->m_pNextNode = other.m_pFirstNode;
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    for (Node *pNode = other.m_pFirstNode; pNode != pLastNode->m_pNextNode;
+      pNode = pNode->m_pNextNode) {
+      pHashIndex->inserted(pNode);
+    }
+  }
+  other.m_pFirstNode = 0;
+  allNodesMoved(other);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+  other.rebuildHashIndex();
+}
+
+/**
+ * Move the elements of other strictly between first and last after position (other may be the
+ * list itself, provided position is not within the range). The cost is linear in the length of
+ * the range, and constant when a single element is moved
+ */
+void SList::splice_after(ConstIterator position, SList &other, ConstIterator first, ConstIterator last)
+{
+  assert(canSpliceFrom(other));
+
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pBeforeFirstNode = const_cast<Node *>(first.m_pNode);
+  Node *pEndNode = const_cast<Node *>(last.m_pNode);
+
+  // Nothing to move, or the range already follows position
+  if (pBeforeFirstNode->m_pNextNode == pEndNode || pPositionNode == pBeforeFirstNode) {
+    return;
+  }
+
+  Node *pFirstNode = pBeforeFirstNode->m_pNextNode;
+  Node *pLastNode = pFirstNode;
+  std::size_t count = 1;
+  for (; pLastNode->m_pNextNode != pEndNode; ++count) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  // Within the list, the same nodes stay indexed. Otherwise, they move from one index to the other
+  NodeHashIndex *pHashIndex = hashIndex();
+  NodeHashIndex *pOtherHashIndex = other.hashIndex();
+  if (&other != this) {
+    for (Node *pNode = pFirstNode; pNode != pEndNode; pNode = pNode->m_pNextNode) {
+      if (pOtherHashIndex) {
+        pOtherHashIndex->erased(pNode);
+      }
+      if (pHashIndex) {
+        pHashIndex->inserted(pNode);
+      }
     }
-    // Add following nodes
-    else {
-      pNode->m_pNextNode = new Node(pRhsNode->m_value, 0);
-      pNode = pNode->m_pNextNode;
+  }
+  pBeforeFirstNode->m_pNextNode = pEndNode;
+  pLastNode->m_pNextNode = pPositionNode->m_pNextNode;
+  pPositionNode->m_pNextNode = pFirstNode;
+  nodesMoved(other, count);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+}
+
+/**
+ * Remove the elements strictly between position and last. Constant time per element
+ */
+SList::Iterator SList::erase_after(ConstIterator position, ConstIterator last)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pEndNode = const_cast<Node *>(last.m_pNode);
+  NodeHashIndex *pHashIndex = hashIndex();
+  while (pPositionNode->m_pNextNode != pEndNode) {
+    Node *pNode = pPositionNode->m_pNextNode;
+    if (pHashIndex) {
+      pHashIndex->erased(pNode);
     }
-    pRhsNode = pRhsNode->m_pNextNode;
+    pPositionNode->m_pNextNode = pNode->m_pNextNode;
+    recycleNode(pNode);
+    nodeDestroyed();
   }
+  invalidateSkipIndex();
+  return Iterator(pEndNode);
+}
+
+/**
+ * Index positional access with one entry every stride elements, or stop indexing it if stride is
+ * 0. The index is built by the first positional access, and kept up to date by push_front()
+ */
+void SList::setSkipIndexStride(std::size_t stride)
+{
+  if (! stride) {
+    if (m_pExtension) {
+      delete m_pExtension->m_pSkipIndex;
+      m_pExtension->m_pSkipIndex = 0;
+      releaseUnusedExtension();
+    }
+    return;
+  }
+
+  SkipIndex<Node> *pSkipIndex = new SkipIndex<Node>(stride);
+  try {
+    extension();
+  }
+  catch (...) {
+    delete pSkipIndex;
+    throw;
+  }
+  delete m_pExtension->m_pSkipIndex;
+  m_pExtension->m_pSkipIndex = pSkipIndex;
+}
+
+/**
+ * Index lookups by value with a hash table, or stop indexing them. The index is built at once,
+ * unless it already is, and kept up to date as elements are inserted and erased
+ */
+void SList::setHashIndexEnabled(bool isEnabled)
+{
+  if (! isEnabled) {
+    if (m_pExtension) {
+      delete m_pExtension->m_pHashIndex;
+      m_pExtension->m_pHashIndex = 0;
+      releaseUnusedExtension();
+    }
+    return;
+  }
+
+  if (! hashIndex()) {
+    NodeHashIndex *pHashIndex = new NodeHashIndex;
+    try {
+      extension().m_pHashIndex = pHashIndex;
+    }
+    catch (...) {
+      delete pHashIndex;
+      throw;
+    }
+  }
+  if (! m_pExtension->m_pHashIndex->isBuilt()) {
+    m_pExtension->m_pHashIndex->build(m_pFirstNode);
+  }
+}
+
+/**
+ * Bytes allocated by the hash index, 0 if the list is not indexed
+ */
+std::size_t SList::hashIndexMemoryUsage() const
+{
+  NodeHashIndex *pHashIndex = hashIndex();
+  return pHashIndex ? pHashIndex->memoryUsage() : 0;
+}
+
+/**
+ * Return an iterator to an element equal to value, or end() if there is none. Without a hash
+ * index, this is the first such element, found by walking the list. With one, any of them may be
+ * returned, in constant time on average
+ */
+SList::ConstIterator SList::find(const std::string &value) const
+{
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex && pHashIndex->isBuilt()) {
+    return ConstIterator(pHashIndex->find(value));
+  }
+
+  const Node *pNode = m_pFirstNode;
+  while (pNode && pNode->m_value != value) {
+    pNode = pNode->m_pNextNode;
+  }
+  return ConstIterator(pNode);
+}
+
+SList::Iterator SList::find(const std::string &value)
+{
+  return Iterator(const_cast<Node *>(static_cast<const SList &>(*this).find(value).m_pNode));
+}
+
+bool SList::contains(const std::string &value) const
+{
+  return find(value) != end();
+}
+
+/**
+ * Return the element at the given position. Throws std::out_of_range if the list is shorter.
+ * Linear in position, or in the stride if the list is indexed
+ */
+const std::string &SList::at(std::size_t position) const
+{
+  return nodeAt(position)->m_value;
+}
+
+/**
+ * Return an iterator n elements after it, or end() if the list is shorter. Linear in n, or
+ * in the stride if the list is indexed
+ */
+SList::ConstIterator SList::advance(ConstIterator it, std::size_t n) const
+{
+  return ConstIterator(advanceNode(const_cast<Node *>(it.m_pNode), n));
+}
+
+SList::Iterator SList::advance(Iterator it, std::size_t n)
+{
+  return Iterator(advanceNode(it.m_pNode, n));
+}
+
+SList::Node *SList::nodeAt(std::size_t position) const
+{
+  Node *pNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pNode = pSkipIndex->nodeAt(m_pFirstNode, position);
+  }
+  else {
+    pNode = advanceNode(m_pFirstNode, position);
+  }
+
+  if (! pNode) {
+    throw std::out_of_range("SList::at");
+  }
+  return pNode;
+}
+
+SList::Node *SList::advanceNode(Node *pNode, std::size_t n) const
+{
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    return pSkipIndex->advance(m_pFirstNode, pNode, n);
+  }
+
+  for (; n > 0 && pNode; --n) {
+    pNode = pNode->m_pNextNode;
+  }
+  return pNode;
+}
+
+/**
+ * Create the pool from which the nodes of a pooled list are drawn
+ */
+NodePool *SList::createNodePool(std::size_t nodesPerChunk)
+{
+  return new NodePool(sizeof(Node), nodesPerChunk);
+}
+
+/**
+ * Return the extension of the list, which is allocated by the first feature needing it
+ */
+SList::Extension &SList::extension()
+{
+  if (! m_pExtension) {
+    m_pExtension = new Extension;
+  }
+  return *m_pExtension;
+}
+
+/**
+ * Free the extension once the last feature using it is turned off
+ */
+void SList::releaseUnusedExtension()
+{
+  if (m_pExtension && ! m_pExtension->isUsed()) {
+    delete m_pExtension;
+    m_pExtension = 0;
+  }
+}
+
+SList::Extension::Extension()
+: m_pNodePool(0),
+  m_pArena(0),
+  m_pSkipIndex(0),
+  m_pHashIndex(0)
+{}
+
+/**
+ * The copy gets a pool and indexes of its own, but shares the arena
+ */
+SList::Extension::Extension(const Extension &rhs)
+: m_pNodePool(0),
+  m_pArena(rhs.m_pArena),
+  m_pSkipIndex(0),
+  m_pHashIndex(0)
+{
+  try {
+    if (rhs.m_pNodePool) {
+      m_pNodePool = createNodePool(rhs.m_pNodePool->nodesPerChunk());
+    }
+    if (rhs.m_pSkipIndex) {
+      m_pSkipIndex = new SkipIndex<Node>(rhs.m_pSkipIndex->stride());
+    }
+    if (rhs.m_pHashIndex) {
+      m_pHashIndex = new NodeHashIndex;
+    }
+  }
+  catch (...) {
+    delete m_pNodePool;
+    delete m_pSkipIndex;
+    throw;
+  }
+}
+
+SList::Extension::~Extension()
+{
+  delete m_pNodePool;
+  delete m_pSkipIndex;
+  delete m_pHashIndex;
+}
+
+bool SList::Extension::isUsed() const
+{
+  return m_pNodePool || m_pArena || m_pSkipIndex || m_pHashIndex;
 }
 
 /**
@@ -33,11 +418,149 @@ void SList::createFrom(const SList &rhs)
  */
 void SList::release()
 {
+  Stopwatch stopwatch;
+  NodePool *pNodePool = nodePool();
   Node *pNode = m_pFirstNode;
+  Node *pAheadNode = prefetchNodesAhead(pNode);
+  if (pNodePool || arena()) {
+    // Only destroy the values. Pooled storage is given back to the global heap in bulk, one chunk
+    // at a time, and arena storage when the arena is reset
+    while (pNode) {
+      pAheadNode = prefetchNextNode(pAheadNode);
+      Node *pNextNode = pNode->m_pNextNode;
+      pNode->~Node();
+      pNode = pNextNode;
+    }
+    if (pNodePool) {
+      pNodePool->release();
+    }
+  }
+  else {
+    while (pNode) {
+      pAheadNode = prefetchNextNode(pAheadNode);
+      Node *pNextNode = pNode->m_pNextNode;
+      destroyNode(pNode);
+      pNode = pNextNode;
+    }
+  }
+  m_pFirstNode = 0;
+  releaseRecycledNodes();
+  invalidateSkipIndex();
+  // Built again by createFrom() if the list is assigned to
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->invalidate();
+  }
+  allNodesDestroyed();
+  released(stopwatch);
+}
+
+/**
+ * Free the storage of recycled nodes. Arena storage is only reclaimed when the arena is reset
+ */
+void SList::releaseRecycledNodes()
+{
+  if (! arena()) {
+    while (m_pFirstRecycledNode) {
+      RecycledNode *pNextRecycledNode = m_pFirstRecycledNode->m_pNextRecycledNode;
+      ::operator delete(m_pFirstRecycledNode);
+      m_pFirstRecycledNode = pNextRecycledNode;
+    }
+  }
+  m_pFirstRecycledNode = 0;
+}
+
+/**
+ * Move the nodes of a pooled or arena list into contiguous storage, in list order, so that
+ * traversals walk memory sequentially. The values are moved, not copied. Iterators, pointers and
+ * references to the elements are invalidated. Linear in the length of the list
+ *   - a pooled list moves its nodes to a new pool, whose chunks are carved in order, and releases
+ *     the former pool
+ *   - an arena list takes a single block from its arena. The storage of the former nodes is lost
+ *     until the arena is reset
+ *   - a heap list only frees its recycled storage: Its nodes must remain freeable one by one, and
+ *     heap nodes allocated one after the other are not laid out in order once the heap has free
+ *     storage of their size
+ * If memory runs out, the list is left unchanged
+ */
+void SList::compact()
+{
+  NodePool *pNodePool = nodePool();
+  MonotonicArena *pArena = arena();
+  if (! pNodePool && ! pArena) {
+    releaseRecycledNodes();
+    return;
+  }
+
+  std::size_t count = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    ++count;
+  }
+
+  NodePool *pCompactedNodePool = 0;
+  Node *pCompactedNodes = 0;
+  if (pNodePool) {
+    pCompactedNodePool = createNodePool(pNodePool->nodesPerChunk());
+  }
+  else if (count > 0) {
+    pCompactedNodes = static_cast<Node *>(pArena->allocate(count * sizeof(Node), alignof(Node)));
+  }
+
+  Node *pFirstNode = 0;
+  Node **ppNextNode = &pFirstNode;
+  Node *pNode = m_pFirstNode;
+  try {
+    for (std::size_t i = 0; pNode; ++i, pNode = pNode->m_pNextNode) {
+      void *pStorage = pCompactedNodePool ? pCompactedNodePool->allocate() : pCompactedNodes + i;
+      *ppNextNode = new (pStorage) Node(std::move(pNode->m_value), 0);
+      ppNextNode = &(*ppNextNode)->m_pNextNode;
+    }
+  }
+  catch (...) {
+    // Only the new pool may run out of memory. Moving strings does not throw, so the values
+    // moved so far are simply moved back
+    for (Node *pOldNode = m_pFirstNode; pFirstNode; pOldNode = pOldNode->m_pNextNode) {
+      Node *pNextNode = pFirstNode->m_pNextNode;
+      pOldNode->m_value = std::move(pFirstNode->m_value);
+      pFirstNode->~Node();
+      pFirstNode = pNextNode;
+    }
+    delete pCompactedNodePool;
+    throw;
+  }
+
+  // The storage of the former nodes goes with the former pool, or stays in the arena
+  pNode = m_pFirstNode;
   while (pNode) {
     Node *pNextNode = pNode->m_pNextNode;
-    delete pNode;
+    pNode->~Node();
     pNode = pNextNode;
   }
-  m_pFirstNode = 0;
+  releaseRecycledNodes();
+
+  if (pNodePool) {
+    delete pNodePool;
+    m_pExtension->m_pNodePool = pCompactedNodePool;
+  }
+  m_pFirstNode = pFirstNode;
+  invalidateSkipIndex();
+  rebuildHashIndex();
+}
+
+/**
+ * Fragmentation metric: The mean distance, in bytes, between the addresses of consecutive nodes.
+ * It is about the size of a node once the list is compacted, and grows as its nodes get scattered.
+ * 0 for lists of less than two elements
+ */
+double SList::meanNodeStride() const
+{
+  double totalStride = 0;
+  std::size_t strideCount = 0;
+  for (const Node *pNode = m_pFirstNode; pNode && pNode->m_pNextNode; pNode = pNode->m_pNextNode) {
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pNode);
+    std::uintptr_t nextAddress = reinterpret_cast<std::uintptr_t>(pNode->m_pNextNode);
+    totalStride += address < nextAddress ? nextAddress - address : address - nextAddress;
+    ++strideCount;
+  }
+  return strideCount ? totalStride / strideCount : 0;
 }
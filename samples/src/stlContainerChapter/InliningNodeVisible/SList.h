@@ -2,17 +2,51 @@
  * Implementation of a list holding standard strings
  *   - only std::string objects are stored
  *   - inlining is performed. We allow the Node structure definition to be revealed
+ *   - statistics are collected by DefaultListStats (see ListStats.h), from which the list inherits
+ *     privately. Unless LIST_STATS is defined to 1, it takes no room and its hooks compile to
+ *     nothing
+ *   - nodes removed by pop_front and erase_after are recycled: Their storage is kept by the list
+ *     and reused by the next nodes it creates, so that pushing and popping never hit the heap once
+ *     the list has reached its usual length. The recycled storage is freed with the list (or when
+ *     it is assigned to). Pooled lists give the storage back to their pool, which does the same
+ *   - compact() moves the nodes of a pooled or arena list whose nodes got scattered into contiguous
+ *     storage, in list order, so that traversals walk memory sequentially again. meanNodeStride()
+ *     tells how scattered the nodes are. Heap nodes are freed one by one, so heap lists are not
+ *     compacted
+ *   - values are immutable: They cannot be modified in place, not even through Iterator, so that
+ *     the hash index never goes stale. An element is replaced by inserting the new value and
+ *     erasing the former one
+ *   - membership tests and lookups (contains, find) walk the list, unless it is hash indexed (see
+ *     setHashIndexEnabled() and HashIndex.h): They then cost O(1) on average, for 21 to 43 bytes
+ *     per element. The index is built when it is enabled, and kept up to date by every
+ *     modification. Lookups do not modify it, so that they may run on several threads at once. If
+ *     memory runs out while it grows, lookups walk the list until setHashIndexEnabled(true),
+ *     compact() or an assignment builds it again
+ *   - the state of the features above which most lists do not use (pool, arena, indexes) lives in
+ *     an extension, allocated by the first of them, so that a plain list takes three pointers
  */
 
 #ifndef SLIST_H
 #define SLIST_H
 
+#include "HashIndex.h"
+#include "ListStats.h"
+#include "MonotonicArena.h"
+#include "NodePool.h"
+#include "SkipIndex.h"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
 #include <string>
+#include <utility>
 
-class SList {
+class SList : private DefaultListStats {
 private:
   struct Node {
     Node(const std::string &value, Node *pNextNode);
+    Node(std::string &&value, Node *pNextNode);
 
     std::string m_value;
     Node *m_pNextNode;
@@ -50,8 +84,8 @@ public:
     Iterator &operator++();
     const Iterator operator++(int);
 
-    std::string *operator->() const;
-    std::string &operator*() const;
+    const std::string *operator->() const;
+    const std::string &operator*() const;
 
     friend bool operator==(const Iterator &lhs, const Iterator &rhs);
     friend bool operator!=(const Iterator &lhs, const Iterator &rhs);
@@ -66,6 +100,8 @@ public:
   };
 
   SList();
+  explicit SList(std::size_t nodesPerChunk);
+  explicit SList(MonotonicArena &arena);
   
   SList(const SList &rhs);
   SList &operator=(const SList &rhs);
@@ -79,12 +115,104 @@ public:
   Iterator end();
 
   void push_front(const std::string &value);
+  template<class InputIterator>
+  void push_front(InputIterator first, InputIterator last);
+  void pop_front();
+
+  Iterator insert_after(ConstIterator position, const std::string &value);
+  Iterator erase_after(ConstIterator position);
+  Iterator erase_after(ConstIterator position, ConstIterator last);
+
+  void splice_front(SList &other);
+  void splice_after(ConstIterator position, SList &other);
+  void splice_after(ConstIterator position, SList &other, ConstIterator first, ConstIterator last);
+
+  void sort();
+  template<class Compare>
+  void sort(Compare compare);
+
+  void merge(SList &other);
+  template<class Compare>
+  void merge(SList &other, Compare compare);
+
+  void setSkipIndexStride(std::size_t stride);
+  void setHashIndexEnabled(bool isEnabled);
+  std::size_t hashIndexMemoryUsage() const;
+
+  const std::string &at(std::size_t position) const;
+
+  ConstIterator advance(ConstIterator it, std::size_t n) const;
+  Iterator advance(Iterator it, std::size_t n);
+
+  ConstIterator find(const std::string &value) const;
+  Iterator find(const std::string &value);
+  bool contains(const std::string &value) const;
+
+  void compact();
+  double meanNodeStride() const;
 
 private:
+  typedef HashIndex<Node, std::hash<std::string> > NodeHashIndex;
+
+  // Storage of an erased node, linked through its own storage until it is reused
+  struct RecycledNode {
+    RecycledNode *m_pNextRecycledNode;
+  };
+
+  // State of the features which most lists do not use. At most one of the pool and the arena is
+  // set
+  struct Extension {
+    Extension();
+    Extension(const Extension &rhs);
+    ~Extension();
+
+    bool isUsed() const;
+
+    NodePool *m_pNodePool;
+    MonotonicArena *m_pArena;
+    SkipIndex<Node> *m_pSkipIndex;
+    NodeHashIndex *m_pHashIndex;
+
+  private:
+    Extension &operator=(const Extension &);
+  };
+
+  template<class Compare>
+  static Node *mergeChains(Node *pLeftNode, Node *pRightNode, Compare compare);
+
+  static NodePool *createNodePool(std::size_t nodesPerChunk);
+
   void createFrom(const SList &rhs);
   void release();
 
+  Node *createNode(const std::string &value, Node *pNextNode);
+  void destroyNode(Node *pNode);
+  void recycleNode(Node *pNode);
+  void releaseRecycledNodes();
+
+  bool canSpliceFrom(const SList &other) const;
+
+  Node *nodeAt(std::size_t position) const;
+  Node *advanceNode(Node *pNode, std::size_t n) const;
+  void invalidateSkipIndex();
+  void rebuildHashIndex();
+
+  // Null if the corresponding feature is not used, which includes lists without an extension
+  NodePool *nodePool() const;
+  MonotonicArena *arena() const;
+  SkipIndex<Node> *skipIndex() const;
+  NodeHashIndex *hashIndex() const;
+
+  Extension &extension();
+  void releaseUnusedExtension();
+
   Node *m_pFirstNode;
+
+  // Storage of erased nodes, to be reused. Always null for pooled lists
+  RecycledNode *m_pFirstRecycledNode;
+
+  // Null until a list uses a pool, an arena or an index
+  Extension *m_pExtension;
 };
 
 inline SList::Node::Node(const std::string &value, Node *pNextNode)
@@ -92,6 +220,11 @@ inline SList::Node::Node(const std::string &value, Node *pNextNode)
   m_pNextNode(pNextNode)
 {}
 
+inline SList::Node::Node(std::string &&value, Node *pNextNode)
+: m_value(std::move(value)),
+  m_pNextNode(pNextNode)
+{}
+
 inline SList::ConstIterator::ConstIterator()
 : m_pNode(0)
 {}
@@ -103,6 +236,7 @@ inline SList::ConstIterator::ConstIterator(const Iterator &rhs)
 inline SList::ConstIterator &SList::ConstIterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
+  DefaultListStats::traversalStep();
   return *this;
 }
 
@@ -110,6 +244,7 @@ inline const SList::ConstIterator SList::ConstIterator::operator++(int)
 {
   ConstIterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
+  DefaultListStats::traversalStep();
   return tmp;
 }
 
@@ -144,6 +279,7 @@ inline SList::Iterator::Iterator()
 inline SList::Iterator &SList::Iterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
+  DefaultListStats::traversalStep();
   return *this;
 }
 
@@ -151,15 +287,16 @@ inline const SList::Iterator SList::Iterator::operator++(int)
 {
   Iterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
+  DefaultListStats::traversalStep();
   return tmp;
 }
 
-inline std::string *SList::Iterator::operator->() const
+inline const std::string *SList::Iterator::operator->() const
 {
   return &m_pNode->m_value;
 }
 
-inline std::string &SList::Iterator::operator*() const
+inline const std::string &SList::Iterator::operator*() const
 {
   return m_pNode->m_value;
 }
@@ -179,13 +316,54 @@ inline SList::Iterator::Iterator(Node *pNode)
 {}
 
 inline SList::SList()
-: m_pFirstNode(0)
+: m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(0)
 {}
 
+inline SList::SList(std::size_t nodesPerChunk)
+: m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(new Extension)
+{
+  try {
+    m_pExtension->m_pNodePool = createNodePool(nodesPerChunk);
+  }
+  catch (...) {
+    delete m_pExtension;
+    throw;
+  }
+}
+
+/**
+ * Create an empty list whose nodes are allocated in the given arena, which must outlive the list.
+ * Destroying the list only destroys the values; the node storage is reclaimed when the arena is
+ * reset
+ */
+inline SList::SList(MonotonicArena &arena)
+: m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(new Extension)
+{
+  m_pExtension->m_pArena = &arena;
+}
+
+/**
+ * A copy gets a pool and indexes of its own, but shares the arena of the original list
+ */
 inline SList::SList(const SList &rhs)
-: m_pFirstNode(0)
+: DefaultListStats(),
+  m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(rhs.m_pExtension ? new Extension(*rhs.m_pExtension) : 0)
 {
-  createFrom(rhs);
+  try {
+    createFrom(rhs);
+  }
+  catch (...) {
+    delete m_pExtension;
+    throw;
+  }
 }
 
 inline SList &SList::operator=(const SList &rhs)
@@ -201,15 +379,18 @@ inline SList &SList::operator=(const SList &rhs)
 inline SList::~SList()
 {
   release();
+  delete m_pExtension;
 }
 
 inline SList::ConstIterator SList::begin() const
 {
+  traversalStarted();
   return ConstIterator(m_pFirstNode);
 }
 
 inline SList::Iterator SList::begin()
 {
+  traversalStarted();
   return Iterator(m_pFirstNode);
 }
 
@@ -225,8 +406,346 @@ inline SList::Iterator SList::end()
 
 inline void SList::push_front(const std::string &value)
 {
-  Node *pNode = new Node(value, m_pFirstNode);
+  Node *pNode = createNode(value, m_pFirstNode);
   m_pFirstNode = pNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(pNode);
+  }
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->inserted(pNode);
+  }
+}
+
+/**
+ * Insert copies of the values in [first, last) at the front of the list, in the same order. The
+ * new nodes are chained locally and published with a single update of the first node, so that
+ * the list is left unchanged if a copy throws
+ */
+template<class InputIterator>
+inline void SList::push_front(InputIterator first, InputIterator last)
+{
+  Node *pFirstNode = 0;
+  Node **ppNextNode = &pFirstNode;
+  std::size_t count = 0;
+  try {
+    for (; first != last; ++first, ++count) {
+      *ppNextNode = createNode(*first, 0);
+      ppNextNode = &(*ppNextNode)->m_pNextNode;
+    }
+  }
+  catch (...) {
+    while (pFirstNode) {
+      Node *pNextNode = pFirstNode->m_pNextNode;
+      destroyNode(pFirstNode);
+      nodeDestroyed();
+      pFirstNode = pNextNode;
+    }
+    throw;
+  }
+  *ppNextNode = m_pFirstNode;
+  m_pFirstNode = pFirstNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(pFirstNode, count);
+  }
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    for (Node *pNode = pFirstNode; count > 0; --count, pNode = pNode->m_pNextNode) {
+      pHashIndex->inserted(pNode);
+    }
+  }
+}
+
+/**
+ * Remove the first element. The list must not be empty
+ */
+inline void SList::pop_front()
+{
+  assert(m_pFirstNode != 0);
+
+  Node *pNode = m_pFirstNode;
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->erased(pNode);
+  }
+  m_pFirstNode = pNode->m_pNextNode;
+  recycleNode(pNode);
+  nodeDestroyed();
+  invalidateSkipIndex();
+}
+
+/**
+ * Insert a copy of value after position, which must not be end(), and return an iterator to it
+ */
+inline SList::Iterator SList::insert_after(ConstIterator position, const std::string &value)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pNode = createNode(value, pPositionNode->m_pNextNode);
+  pPositionNode->m_pNextNode = pNode;
+  invalidateSkipIndex();
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->inserted(pNode);
+  }
+  return Iterator(pNode);
+}
+
+/**
+ * Remove the element after position, which must exist, and return an iterator to the element
+ * which followed it
+ */
+inline SList::Iterator SList::erase_after(ConstIterator position)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pNode = pPositionNode->m_pNextNode;
+  assert(pNode != 0);
+
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->erased(pNode);
+  }
+  pPositionNode->m_pNextNode = pNode->m_pNextNode;
+  recycleNode(pNode);
+  nodeDestroyed();
+  invalidateSkipIndex();
+  return Iterator(pPositionNode->m_pNextNode);
+}
+
+/**
+ * Create a node, drawing its storage from the recycled nodes, or else from the pool or the arena
+ * if the list has one
+ */
+inline SList::Node *SList::createNode(const std::string &value, Node *pNextNode)
+{
+  MonotonicArena *pArena = arena();
+  NodePool *pNodePool = nodePool();
+  Node *pNode;
+  if (m_pFirstRecycledNode) {
+    RecycledNode *pRecycledNode = m_pFirstRecycledNode;
+    m_pFirstRecycledNode = pRecycledNode->m_pNextRecycledNode;
+    try {
+      pNode = new (static_cast<void *>(pRecycledNode)) Node(value, pNextNode);
+    }
+    catch (...) {
+      // The value constructor may have overwritten the link: It is written again
+      pRecycledNode = new (static_cast<void *>(pRecycledNode)) RecycledNode;
+      pRecycledNode->m_pNextRecycledNode = m_pFirstRecycledNode;
+      m_pFirstRecycledNode = pRecycledNode;
+      throw;
+    }
+  }
+  else if (pArena) {
+    // If the value constructor throws, the storage is simply lost until the arena is reset
+    pNode = new (pArena->allocate(sizeof(Node), alignof(Node))) Node(value, pNextNode);
+  }
+  else if (! pNodePool) {
+    pNode = new Node(value, pNextNode);
+  }
+  else {
+    void *pStorage = pNodePool->allocate();
+    try {
+      pNode = new (pStorage) Node(value, pNextNode);
+    }
+    catch (...) {
+      pNodePool->deallocate(pStorage);
+      throw;
+    }
+  }
+  nodeCreated();
+  return pNode;
+}
+
+/**
+ * Destroy a single node created by createNode
+ */
+inline void SList::destroyNode(Node *pNode)
+{
+  NodePool *pNodePool = nodePool();
+  if (arena()) {
+    pNode->~Node();
+  }
+  else if (! pNodePool) {
+    delete pNode;
+  }
+  else {
+    pNode->~Node();
+    pNodePool->deallocate(pNode);
+  }
+}
+
+/**
+ * Destroy a node removed from the list, and keep its storage for the next node created. Pooled
+ * storage is given back to the pool, which recycles it the same way
+ */
+inline void SList::recycleNode(Node *pNode)
+{
+  pNode->~Node();
+  NodePool *pNodePool = nodePool();
+  if (pNodePool) {
+    pNodePool->deallocate(pNode);
+    return;
+  }
+
+  RecycledNode *pRecycledNode = new (static_cast<void *>(pNode)) RecycledNode;
+  pRecycledNode->m_pNextRecycledNode = m_pFirstRecycledNode;
+  m_pFirstRecycledNode = pRecycledNode;
+}
+
+/**
+ * Stable sort, in ascending order according to operator<
+ */
+inline void SList::sort()
+{
+  sort(std::less<std::string>());
+}
+
+/**
+ * Stable bottom-up merge sort. Only the links between nodes are changed: Nothing is allocated,
+ * copied or moved, and iterators remain valid. Runs of 2^i nodes are kept in bins, and merged
+ * together like the digits of a binary counter are carried
+ */
+template<class Compare>
+inline void SList::sort(Compare compare)
+{
+  // Enough bins for any list which fits in memory
+  const std::size_t binCount = 64;
+  Node *bins[binCount] = {};
+  std::size_t usedBinCount = 0;
+
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pRunNode = pNode;
+    pNode = pNode->m_pNextNode;
+    pRunNode->m_pNextNode = 0;
+
+    // Bins contain nodes which come before the run, so they are merged on the left for stability
+    std::size_t i = 0;
+    for (; i < usedBinCount && bins[i]; ++i) {
+      pRunNode = mergeChains(bins[i], pRunNode, compare);
+      bins[i] = 0;
+    }
+    if (i == binCount) {
+      --i;
+    }
+    bins[i] = pRunNode;
+    if (i == usedBinCount) {
+      ++usedBinCount;
+    }
+  }
+
+  Node *pFirstNode = 0;
+  for (std::size_t i = 0; i < usedBinCount; ++i) {
+    pFirstNode = mergeChains(bins[i], pFirstNode, compare);
+  }
+  m_pFirstNode = pFirstNode;
+  invalidateSkipIndex();
+}
+
+/**
+ * Merge other, which must be sorted as the list, into the list. other is left empty
+ */
+inline void SList::merge(SList &other)
+{
+  merge(other, std::less<std::string>());
+}
+
+/**
+ * Merge other, which must be sorted as the list according to compare, into the list. Equivalent
+ * elements of the list come first. Nodes are relinked, nothing is allocated or copied. other is
+ * left empty
+ */
+template<class Compare>
+inline void SList::merge(SList &other, Compare compare)
+{
+  assert(canSpliceFrom(other));
+
+  if (&other == this) {
+    return;
+  }
+
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    for (Node *pNode = other.m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+      pHashIndex->inserted(pNode);
+    }
+  }
+  m_pFirstNode = mergeChains(m_pFirstNode, other.m_pFirstNode, compare);
+  other.m_pFirstNode = 0;
+  allNodesMoved(other);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+  other.rebuildHashIndex();
+}
+
+/**
+ * Merge two sorted chains of nodes and return the first node of the result. Stable: when
+ * elements are equivalent, those of the left chain come first
+ */
+template<class Compare>
+inline SList::Node *SList::mergeChains(Node *pLeftNode, Node *pRightNode, Compare compare)
+{
+  Node *pFirstNode = 0;
+  Node **ppNextNode = &pFirstNode;
+  while (pLeftNode && pRightNode) {
+    if (compare(pRightNode->m_value, pLeftNode->m_value)) {
+      *ppNextNode = pRightNode;
+      pRightNode = pRightNode->m_pNextNode;
+    }
+    else {
+      *ppNextNode = pLeftNode;
+      pLeftNode = pLeftNode->m_pNextNode;
+    }
+    ppNextNode = &(*ppNextNode)->m_pNextNode;
+  }
+  *ppNextNode = pLeftNode ? pLeftNode : pRightNode;
+  return pFirstNode;
+}
+
+/**
+ * Nodes can only be moved between lists which both allocate them on the global heap or in the
+ * same arena, since a pool only gives back nodes it created itself
+ */
+inline bool SList::canSpliceFrom(const SList &other) const
+{
+  return &other == this || (! nodePool() && ! other.nodePool() && arena() == other.arena());
+}
+
+inline void SList::invalidateSkipIndex()
+{
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->invalidate();
+  }
+}
+
+inline void SList::rebuildHashIndex()
+{
+  NodeHashIndex *pHashIndex = hashIndex();
+  if (pHashIndex) {
+    pHashIndex->build(m_pFirstNode);
+  }
+}
+
+inline NodePool *SList::nodePool() const
+{
+  return m_pExtension ? m_pExtension->m_pNodePool : 0;
+}
+
+inline MonotonicArena *SList::arena() const
+{
+  return m_pExtension ? m_pExtension->m_pArena : 0;
+}
+
+inline SkipIndex<SList::Node> *SList::skipIndex() const
+{
+  return m_pExtension ? m_pExtension->m_pSkipIndex : 0;
+}
+
+inline SList::NodeHashIndex *SList::hashIndex() const
+{
+  return m_pExtension ? m_pExtension->m_pHashIndex : 0;
 }
 
 #endif
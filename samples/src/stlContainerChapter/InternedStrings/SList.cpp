@@ -0,0 +1,80 @@
+#include "SList.h"
+
+/**
+ * The value is looked up in the pool once, without adding it: A value which was never interned
+ * cannot be in the list. The list is then searched for the handle
+ */
+SList::ConstIterator SList::find(const std::string &value) const
+{
+  const std::string *pValue = m_pPool->find(value);
+  if (! pValue) {
+    return end();
+  }
+
+  const Node *pNode = m_pFirstNode;
+  while (pNode && pNode->m_pValue != pValue) {
+    pNode = pNode->m_pNextNode;
+  }
+  return ConstIterator(pNode);
+}
+
+SList::Iterator SList::find(const std::string &value)
+{
+  return Iterator(const_cast<Node *>(static_cast<const SList &>(*this).find(value).m_pNode));
+}
+
+/**
+ * Lists sharing a pool are compared handle by handle. Otherwise, the values are compared
+ */
+bool operator==(const SList &lhs, const SList &rhs)
+{
+  const SList::Node *pLhsNode = lhs.m_pFirstNode;
+  const SList::Node *pRhsNode = rhs.m_pFirstNode;
+  if (lhs.m_pPool == rhs.m_pPool) {
+    while (pLhsNode && pRhsNode && pLhsNode->m_pValue == pRhsNode->m_pValue) {
+      pLhsNode = pLhsNode->m_pNextNode;
+      pRhsNode = pRhsNode->m_pNextNode;
+    }
+  }
+  else {
+    while (pLhsNode && pRhsNode && *pLhsNode->m_pValue == *pRhsNode->m_pValue) {
+      pLhsNode = pLhsNode->m_pNextNode;
+      pRhsNode = pRhsNode->m_pNextNode;
+    }
+  }
+  return ! pLhsNode && ! pRhsNode;
+}
+
+/**
+ * Function factoring out the code for creating a list from an existing one. Must
+ * be called only on an empty list. Only the handles are copied: The pool is not touched
+ */
+void SList::createFrom(const SList &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_pFirstNode == 0);
+  assert(m_pPool == rhs.m_pPool);
+
+  Node **ppNextNode = &m_pFirstNode;
+  for (const Node *pRhsNode = rhs.m_pFirstNode; pRhsNode; pRhsNode = pRhsNode->m_pNextNode) {
+    Node *pNode = new Node;
+    pNode->m_pValue = pRhsNode->m_pValue;
+    pNode->m_pNextNode = 0;
+    *ppNextNode = pNode;
+    ppNextNode = &pNode->m_pNextNode;
+  }
+}
+
+/**
+ * Function factoring out the cleanup code. The values stay in the pool
+ */
+void SList::release()
+{
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pNextNode = pNode->m_pNextNode;
+    delete pNode;
+    pNode = pNextNode;
+  }
+  m_pFirstNode = 0;
+}
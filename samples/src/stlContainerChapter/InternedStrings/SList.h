@@ -0,0 +1,294 @@
+/**
+ * Implementation of a list holding strings
+ *   - strings are interned: Each node holds a handle (a pointer) to the value in a StringPool,
+ *     shared by all lists using the pool, instead of a copy of the string. A value repeated in
+ *     many lists or elements is stored once, and copying a list copies handles: One node
+ *     allocation per element, however long the strings are
+ *   - the handles of equal values are equal, so that find, contains and list equality compare
+ *     pointers rather than characters
+ *   - lists use StringPool::global() unless given a pool, which must then outlive them. A copy
+ *     uses the pool of the original. Interning is thread-safe; as for the other lists, a list
+ *     object itself must not be modified by several threads at once
+ *   - values are immutable, since they are shared: They cannot be modified in place, not even
+ *     through Iterator
+ *   - inlining is performed. We allow the Node structure definition to be revealed
+ */
+
+#ifndef SLIST_H
+#define SLIST_H
+
+#include "StringPool.h"
+
+#include <cassert>
+#include <string>
+
+class SList {
+private:
+  struct Node {
+    const std::string *m_pValue;
+    Node *m_pNextNode;
+  };
+
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const std::string *operator->() const;
+    const std::string &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs);
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs);
+
+  private:
+    friend class SList;
+
+    explicit ConstIterator(const Node *);
+
+    const Node *m_pNode;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    const std::string *operator->() const;
+    const std::string &operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs);
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs);
+
+  private:
+    friend class SList;
+    friend class ConstIterator;
+
+    explicit Iterator(Node *pNode);
+
+    Node *m_pNode;
+  };
+
+  SList();
+  explicit SList(StringPool &pool);
+
+  SList(const SList &rhs);
+  SList &operator=(const SList &rhs);
+
+  ~SList();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(const std::string &value);
+  void pop_front();
+
+  ConstIterator find(const std::string &value) const;
+  Iterator find(const std::string &value);
+  bool contains(const std::string &value) const;
+
+  StringPool &pool() const;
+
+  friend bool operator==(const SList &lhs, const SList &rhs);
+  friend bool operator!=(const SList &lhs, const SList &rhs);
+
+private:
+  void createFrom(const SList &rhs);
+  void release();
+
+  StringPool *m_pPool;
+  Node *m_pFirstNode;
+};
+
+inline SList::ConstIterator::ConstIterator()
+: m_pNode(0)
+{}
+
+inline SList::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pNode(rhs.m_pNode)
+{}
+
+inline SList::ConstIterator &SList::ConstIterator::operator++()
+{
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+inline const SList::ConstIterator SList::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  m_pNode = m_pNode->m_pNextNode;
+  return tmp;
+}
+
+inline const std::string *SList::ConstIterator::operator->() const
+{
+  return m_pNode->m_pValue;
+}
+
+inline const std::string &SList::ConstIterator::operator*() const
+{
+  return *m_pNode->m_pValue;
+}
+
+inline bool operator==(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_pNode == rhs.m_pNode;
+}
+
+inline bool operator!=(const SList::ConstIterator &lhs, const SList::ConstIterator &rhs)
+{
+  return lhs.m_pNode != rhs.m_pNode;
+}
+
+inline SList::ConstIterator::ConstIterator(const Node *pNode)
+: m_pNode(pNode)
+{}
+
+inline SList::Iterator::Iterator()
+: m_pNode(0)
+{}
+
+inline SList::Iterator &SList::Iterator::operator++()
+{
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+inline const SList::Iterator SList::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  m_pNode = m_pNode->m_pNextNode;
+  return tmp;
+}
+
+inline const std::string *SList::Iterator::operator->() const
+{
+  return m_pNode->m_pValue;
+}
+
+inline const std::string &SList::Iterator::operator*() const
+{
+  return *m_pNode->m_pValue;
+}
+
+inline bool operator==(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_pNode == rhs.m_pNode;
+}
+
+inline bool operator!=(const SList::Iterator &lhs, const SList::Iterator &rhs)
+{
+  return lhs.m_pNode != rhs.m_pNode;
+}
+
+inline SList::Iterator::Iterator(Node *pNode)
+: m_pNode(pNode)
+{}
+
+inline SList::SList()
+: m_pPool(&StringPool::global()),
+  m_pFirstNode(0)
+{}
+
+inline SList::SList(StringPool &pool)
+: m_pPool(&pool),
+  m_pFirstNode(0)
+{}
+
+inline SList::SList(const SList &rhs)
+: m_pPool(rhs.m_pPool),
+  m_pFirstNode(0)
+{
+  createFrom(rhs);
+}
+
+/**
+ * The list takes the pool of rhs, whose handles it copies
+ */
+inline SList &SList::operator=(const SList &rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    m_pPool = rhs.m_pPool;
+    createFrom(rhs);
+  }
+  return *this;
+}
+
+inline SList::~SList()
+{
+  release();
+}
+
+inline SList::ConstIterator SList::begin() const
+{
+  return ConstIterator(m_pFirstNode);
+}
+
+inline SList::Iterator SList::begin()
+{
+  return Iterator(m_pFirstNode);
+}
+
+inline SList::ConstIterator SList::end() const
+{
+  return ConstIterator(0);
+}
+
+inline SList::Iterator SList::end()
+{
+  return Iterator(0);
+}
+
+/**
+ * Interns value in the pool of the list, unless it is already there
+ */
+inline void SList::push_front(const std::string &value)
+{
+  const std::string *pValue = m_pPool->intern(value);
+  Node *pNode = new Node;
+  pNode->m_pValue = pValue;
+  pNode->m_pNextNode = m_pFirstNode;
+  m_pFirstNode = pNode;
+}
+
+/**
+ * Remove the first element. The list must not be empty. The value stays in the pool
+ */
+inline void SList::pop_front()
+{
+  assert(m_pFirstNode != 0);
+
+  Node *pNode = m_pFirstNode;
+  m_pFirstNode = pNode->m_pNextNode;
+  delete pNode;
+}
+
+inline bool SList::contains(const std::string &value) const
+{
+  return find(value) != end();
+}
+
+inline StringPool &SList::pool() const
+{
+  return *m_pPool;
+}
+
+inline bool operator!=(const SList &lhs, const SList &rhs)
+{
+  return ! (lhs == rhs);
+}
+
+#endif
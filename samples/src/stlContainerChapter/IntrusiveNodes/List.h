@@ -0,0 +1,339 @@
+/**
+ * Implementation of a list container
+ *   - does not conform to the STL conventions
+ *   - friend iterator comparison operators
+ *   - intrusive: the link to the next element lives in the elements themselves, in a ListHook
+ *     member designated by a template argument, as in List<Object, &Object::m_listHook>. The
+ *     list links existing objects instead of storing copies: push_front neither allocates nor
+ *     copies. The objects are owned, and kept alive, by the caller while they are linked
+ *   - an object is linked in at most one list per hook. Objects with several hooks can be linked
+ *     in several lists at once. The hook of an unlinked object holds a sentinel rather than null,
+ *     which ends the lists, so that linking an object twice is caught (by an assertion) even if
+ *     it is the last of its list. An object must be unlinked before it is destroyed
+ */
+
+#ifndef LIST_H
+#define LIST_H
+
+#include <cassert>
+
+template<class T>
+class ListHook;
+
+template<class T, ListHook<T> T::*Hook>
+class List;
+
+/**
+ * Link to be embedded in the objects of an intrusive list. Copying an object does not copy its
+ * links: The copy starts unlinked
+ */
+template<class T>
+class ListHook {
+public:
+  ListHook();
+
+  ListHook(const ListHook &rhs);
+  ListHook &operator=(const ListHook &rhs);
+
+  ~ListHook();
+
+  bool isLinked() const;
+
+private:
+  template<class U, ListHook<U> U::*Hook>
+  friend class List;
+
+  static T *unlinked();
+
+  // unlinked() if the object is in no list through this hook, null if it is the last of its list
+  T *m_pNextObject;
+};
+
+template<class T, ListHook<T> T::*Hook>
+class List {
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const T *operator->() const;
+    const T &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pObject == rhs.m_pObject;
+    }
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pObject != rhs.m_pObject;
+    }
+
+  private:
+    friend class List;
+
+    explicit ConstIterator(const T *);
+
+    const T *m_pObject;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    T *operator->() const;
+    T &operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pObject == rhs.m_pObject;
+    }
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pObject != rhs.m_pObject;
+    }
+
+  private:
+    friend class List;
+    friend class ConstIterator;
+
+    explicit Iterator(T *pObject);
+
+    T *m_pObject;
+  };
+
+  List();
+  ~List();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(T &object);
+  void pop_front();
+  void clear();
+
+private:
+  // Not copyable: An object cannot be linked twice through the same hook
+  List(const List &rhs);
+  List &operator=(const List &rhs);
+
+  static T *nextObject(const T *pObject);
+
+  T *m_pFirstObject;
+};
+
+template<class T>
+ListHook<T>::ListHook()
+: m_pNextObject(unlinked())
+{}
+
+template<class T>
+ListHook<T>::ListHook(const ListHook<T> &/*rhs*/)
+: m_pNextObject(unlinked())
+{}
+
+template<class T>
+ListHook<T> &ListHook<T>::operator=(const ListHook<T> &/*rhs*/)
+{
+  // The object keeps its own place in its list
+  return *this;
+}
+
+/**
+ * The object must have been unlinked, or its list would be left pointing to it
+ */
+template<class T>
+ListHook<T>::~ListHook()
+{
+  assert(! isLinked());
+}
+
+template<class T>
+bool ListHook<T>::isLinked() const
+{
+  return m_pNextObject != unlinked();
+}
+
+/**
+ * Sentinel marking unlinked hooks: The address of an object which is never a list element, and
+ * is never dereferenced
+ */
+template<class T>
+T *ListHook<T>::unlinked()
+{
+  alignas(T) static char s_sentinel;
+  return reinterpret_cast<T *>(&s_sentinel);
+}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::ConstIterator::ConstIterator()
+: m_pObject(0)
+{}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pObject(rhs.m_pObject)
+{}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::ConstIterator &List<T, Hook>::ConstIterator::operator++()
+{
+  m_pObject = nextObject(m_pObject);
+  return *this;
+}
+
+template<class T, ListHook<T> T::*Hook>
+const typename List<T, Hook>::ConstIterator List<T, Hook>::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  m_pObject = nextObject(m_pObject);
+  return tmp;
+}
+
+template<class T, ListHook<T> T::*Hook>
+const T *List<T, Hook>::ConstIterator::operator->() const
+{
+  return m_pObject;
+}
+
+template<class T, ListHook<T> T::*Hook>
+const T &List<T, Hook>::ConstIterator::operator*() const
+{
+  return *m_pObject;
+}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::ConstIterator::ConstIterator(const T *pObject)
+: m_pObject(pObject)
+{}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::Iterator::Iterator()
+: m_pObject(0)
+{}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::Iterator &List<T, Hook>::Iterator::operator++()
+{
+  m_pObject = nextObject(m_pObject);
+  return *this;
+}
+
+template<class T, ListHook<T> T::*Hook>
+const typename List<T, Hook>::Iterator List<T, Hook>::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  m_pObject = nextObject(m_pObject);
+  return tmp;
+}
+
+template<class T, ListHook<T> T::*Hook>
+T *List<T, Hook>::Iterator::operator->() const
+{
+  return m_pObject;
+}
+
+template<class T, ListHook<T> T::*Hook>
+T &List<T, Hook>::Iterator::operator*() const
+{
+  return *m_pObject;
+}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::Iterator::Iterator(T *pObject)
+: m_pObject(pObject)
+{}
+
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::List()
+: m_pFirstObject(0)
+{}
+
+/**
+ * The objects are unlinked, not destroyed
+ */
+template<class T, ListHook<T> T::*Hook>
+List<T, Hook>::~List()
+{
+  clear();
+}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::ConstIterator List<T, Hook>::begin() const
+{
+  return ConstIterator(m_pFirstObject);
+}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::Iterator List<T, Hook>::begin()
+{
+  return Iterator(m_pFirstObject);
+}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::ConstIterator List<T, Hook>::end() const
+{
+  return ConstIterator(0);
+}
+
+template<class T, ListHook<T> T::*Hook>
+typename List<T, Hook>::Iterator List<T, Hook>::end()
+{
+  return Iterator(0);
+}
+
+/**
+ * Link object at the front of the list. It must not be linked in a list through the same hook
+ */
+template<class T, ListHook<T> T::*Hook>
+void List<T, Hook>::push_front(T &object)
+{
+  ListHook<T> &hook = object.*Hook;
+  assert(! hook.isLinked());
+
+  hook.m_pNextObject = m_pFirstObject;
+  m_pFirstObject = &object;
+}
+
+/**
+ * Unlink the first object. The list must not be empty
+ */
+template<class T, ListHook<T> T::*Hook>
+void List<T, Hook>::pop_front()
+{
+  assert(m_pFirstObject != 0);
+
+  ListHook<T> &hook = m_pFirstObject->*Hook;
+  m_pFirstObject = hook.m_pNextObject;
+  hook.m_pNextObject = ListHook<T>::unlinked();
+}
+
+/**
+ * Unlink all objects, so that they can be linked again
+ */
+template<class T, ListHook<T> T::*Hook>
+void List<T, Hook>::clear()
+{
+  while (m_pFirstObject) {
+    pop_front();
+  }
+}
+
+template<class T, ListHook<T> T::*Hook>
+T *List<T, Hook>::nextObject(const T *pObject)
+{
+  return (pObject->*Hook).m_pNextObject;
+}
+
+#endif
@@ -7,6 +7,8 @@
 #ifndef SLIST_H
 #define SLIST_H
 
+#include "NodePool.h"
+
 #include <string>
 
 class SList {
@@ -56,6 +58,7 @@ public:
   };
 
   SList();
+  explicit SList(std::size_t nodesPerChunk);
   
   SList(const SList &rhs);
   SList &operator=(const SList &rhs);
@@ -71,10 +74,16 @@ public:
   void push_front(const std::string &value);
 
 private:
+  static NodePool *createNodePool(std::size_t nodesPerChunk);
+
   void createFrom(const SList &rhs);
   void release();
 
+  Node *createNode(const std::string &value, Node *pNextNode);
+
   Node *m_pFirstNode;
+  // Null if nodes are allocated on the global heap
+  NodePool *m_pNodePool;
 };
 
 #endif
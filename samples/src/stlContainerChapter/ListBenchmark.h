@@ -0,0 +1,307 @@
+/**
+ * Benchmark kernels shared by all list samples. Each sample builds its own benchmark executable,
+ * which instantiates the kernels for its list class. Lists of std::string are used since this
+ * is the only type SList supports. Values are short enough not to require heap allocations of
+ * their own, so that allocation counts only reflect nodes
+ */
+
+#ifndef LISTBENCHMARK_H
+#define LISTBENCHMARK_H
+
+#include "Benchmark.h"
+#include "MonotonicArena.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Small lists are measured several times over, so that each measurement covers about the same
+// number of elements
+const std::size_t s_elementsPerMeasurement = 1000000;
+
+/**
+ * Measure push_front, full traversal, copy (createFrom) and destruction (release) for list sizes
+ * 10, 100, ..., up to maxSize
+ */
+template<class ListType>
+void benchmarkList(std::size_t maxSize)
+{
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::size_t repetitions = size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1;
+    std::size_t operations = repetitions * size;
+
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      values.push_back(std::to_string(i % 1000000));
+    }
+
+    std::vector<ListType> lists(repetitions);
+    BenchmarkCounters counters;
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      ListType &list = lists[r];
+      for (std::size_t i = 0; i < size; ++i) {
+        list.push_front(values[i]);
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("push_front", size, operations, counters);
+
+    counters.start();
+    std::size_t length = 0;
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      const ListType &list = lists[r];
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        length += it->size();
+      }
+    }
+    counters.stop();
+    doNotOptimize(length);
+    printBenchmarkResult("traversal", size, operations, counters);
+
+    std::vector<ListType> copies;
+    copies.reserve(repetitions);
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      copies.push_back(lists[r]);
+    }
+    counters.stop();
+    printBenchmarkResult("copy", size, operations, counters);
+
+    counters.start();
+    copies.clear();
+    counters.stop();
+    printBenchmarkResult("destruction", size, operations, counters);
+  }
+}
+
+// Number of lists the elements are spread over by benchmarkScatteredList()
+const std::size_t s_scatteredListCount = 256;
+
+/**
+ * Measure copy (createFrom) and destruction (release) of long lists whose nodes are scattered in
+ * memory, for total sizes 10^5, 10^6, ..., up to maxSize. The elements are pushed in random order
+ * onto s_scatteredListCount lists, so that consecutive nodes of a list are far apart and the
+ * hardware prefetcher cannot follow the chain. Once the nodes no longer fit in the last level
+ * cache, each step of a traversal is a cache miss, which is what the software prefetching of
+ * Prefetch.h addresses (build with LIST_PREFETCH_DISTANCE=0 to compare with the plain loops)
+ */
+template<class ListType>
+void benchmarkScatteredList(std::size_t maxSize)
+{
+  printBenchmarkHeader();
+  for (std::size_t size = 100000; size <= maxSize; size *= 10) {
+    std::vector<ListType> lists(s_scatteredListCount);
+    std::minstd_rand random;
+    for (std::size_t i = 0; i < size; ++i) {
+      lists[random() % s_scatteredListCount].push_front(std::to_string(i % 1000000));
+    }
+
+    BenchmarkCounters counters;
+    std::vector<ListType> copies;
+    copies.reserve(s_scatteredListCount);
+    counters.start();
+    for (std::size_t l = 0; l < s_scatteredListCount; ++l) {
+      copies.push_back(lists[l]);
+    }
+    counters.stop();
+    printBenchmarkResult("copy (scattered)", size, size, counters);
+    copies.clear();
+
+    counters.start();
+    lists.clear();
+    counters.stop();
+    printBenchmarkResult("destruction (scattered)", size, size, counters);
+  }
+}
+
+/**
+ * Sum the lengths of the values of all lists, to measure traversals
+ */
+template<class ListType>
+std::size_t traverseLists(const std::vector<ListType> &lists)
+{
+  std::size_t length = 0;
+  for (std::size_t l = 0; l < lists.size(); ++l) {
+    for (auto it = lists[l].begin(); it != lists[l].end(); ++it) {
+      length += it->size();
+    }
+  }
+  return length;
+}
+
+/**
+ * Measure full traversals of lists scattered as in benchmarkScatteredList(), then compact() and
+ * traversals of the compacted lists, for total sizes 10^5, 10^6, ..., up to maxSize. The lists
+ * share an arena, since heap lists are not compacted: Their nodes are interleaved in it. The mean
+ * node stride of the lists is printed before and after compaction
+ */
+template<class ListType>
+void benchmarkCompaction(std::size_t maxSize)
+{
+  for (std::size_t size = 100000; size <= maxSize; size *= 10) {
+    MonotonicArena arena;
+    std::vector<ListType> lists;
+    lists.reserve(s_scatteredListCount);
+    for (std::size_t l = 0; l < s_scatteredListCount; ++l) {
+      lists.emplace_back(arena);
+    }
+    std::minstd_rand random;
+    for (std::size_t i = 0; i < size; ++i) {
+      lists[random() % s_scatteredListCount].push_front(std::to_string(i % 1000000));
+    }
+
+    double strideBefore = 0;
+    for (std::size_t l = 0; l < s_scatteredListCount; ++l) {
+      strideBefore += lists[l].meanNodeStride() / s_scatteredListCount;
+    }
+
+    printBenchmarkHeader();
+    BenchmarkCounters counters;
+    counters.start();
+    doNotOptimize(traverseLists(lists));
+    counters.stop();
+    printBenchmarkResult("traversal (scattered)", size, size, counters);
+
+    counters.start();
+    for (std::size_t l = 0; l < s_scatteredListCount; ++l) {
+      lists[l].compact();
+    }
+    counters.stop();
+    printBenchmarkResult("compact", size, size, counters);
+
+    counters.start();
+    doNotOptimize(traverseLists(lists));
+    counters.stop();
+    printBenchmarkResult("traversal (compacted)", size, size, counters);
+
+    double strideAfter = 0;
+    for (std::size_t l = 0; l < s_scatteredListCount; ++l) {
+      strideAfter += lists[l].meanNodeStride() / s_scatteredListCount;
+    }
+    std::printf("mean node stride: %.0f bytes scattered, %.0f bytes compacted\n\n", strideBefore,
+      strideAfter);
+  }
+}
+
+/**
+ * Measure a list used as a stack: size elements are pushed, then popped, over and over. Once the
+ * first round has filled the recycled nodes, no more allocations should be made
+ */
+template<class ListType>
+void benchmarkStackList(std::size_t maxSize)
+{
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::size_t repetitions = size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1;
+    std::size_t operations = repetitions * size;
+
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      values.push_back(std::to_string(i % 1000000));
+    }
+
+    ListType list;
+    BenchmarkCounters counters;
+    for (int round = 0; round < 2; ++round) {
+      counters.start();
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        for (std::size_t i = 0; i < size; ++i) {
+          list.push_front(values[i]);
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+          list.pop_front();
+        }
+      }
+      counters.stop();
+      printBenchmarkResult(round == 0 ? "push+pop (first)" : "push+pop (recycled)", size,
+        operations, counters);
+    }
+  }
+}
+
+inline void makeBenchmarkValue(std::size_t i, std::string &value)
+{
+  value = std::to_string(i % 1000000);
+}
+
+inline void makeBenchmarkValue(std::size_t i, int &value)
+{
+  value = static_cast<int>(i);
+}
+
+/**
+ * Compare building and destroying lists on the global heap with the same work done in a
+ * MonotonicArena, for list sizes 10, 100, ..., up to maxSize. The arena is warmed up by a first
+ * round, so that the measured round reuses its blocks. With an arena, destruction only runs the
+ * value destructors (if any), and the storage of all lists is reclaimed by a single reset
+ */
+template<class ListType, class ValueType>
+void benchmarkArenaList(std::size_t maxSize)
+{
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::size_t repetitions = size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1;
+    std::size_t operations = repetitions * size;
+
+    std::vector<ValueType> values(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      makeBenchmarkValue(i, values[i]);
+    }
+
+    BenchmarkCounters counters;
+    {
+      std::vector<ListType> lists(repetitions);
+      counters.start();
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        ListType &list = lists[r];
+        for (std::size_t i = 0; i < size; ++i) {
+          list.push_front(values[i]);
+        }
+      }
+      counters.stop();
+      printBenchmarkResult("build (heap)", size, operations, counters);
+
+      counters.start();
+      lists.clear();
+      counters.stop();
+      printBenchmarkResult("destroy (heap)", size, operations, counters);
+    }
+
+    MonotonicArena arena;
+    for (int round = 0; round < 2; ++round) {
+      std::vector<ListType> lists;
+      lists.reserve(repetitions);
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        lists.emplace_back(arena);
+      }
+
+      counters.start();
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        ListType &list = lists[r];
+        for (std::size_t i = 0; i < size; ++i) {
+          list.push_front(values[i]);
+        }
+      }
+      counters.stop();
+      if (round == 1) {
+        printBenchmarkResult("build (arena)", size, operations, counters);
+      }
+
+      counters.start();
+      lists.clear();
+      arena.reset();
+      counters.stop();
+      if (round == 1) {
+        printBenchmarkResult("destroy+reset (arena)", size, operations, counters);
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * Constant evaluation of the list templates
+ *   - C++20 lets constant expressions allocate with new, provided that everything they allocate
+ *     is deleted before they end. A list can then be built and used at compile time, but not kept:
+ *     Its contents are copied instead into a flat table, which can be (see ListTable.h)
+ *   - members usable in constant evaluation are declared LIST_CONSTEXPR, which expands to
+ *     constexpr under C++20, and to inline before. Code which cannot run at compile time, such as
+ *     prefetching, is skipped when LIST_IS_CONSTANT_EVALUATED() is true
+ */
+
+#ifndef LISTCONSTEXPR_H
+#define LISTCONSTEXPR_H
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <type_traits>
+
+#define LIST_CONSTEXPR constexpr
+#define LIST_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define LIST_CONSTEXPR inline
+#define LIST_IS_CONSTANT_EVALUATED() false
+#endif
+
+#endif
@@ -0,0 +1,221 @@
+#include "ListFile.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char s_magic[4] = { 'L', 'I', 'S', 'T' };
+const std::uint32_t s_version = 1;
+
+void throwFormatError(const char *fileName, const char *problem)
+{
+  throw std::runtime_error(std::string(fileName) + ": " + problem);
+}
+
+}
+
+/**
+ * The header is written as zeros until finish(), so that an unfinished file is never taken for a
+ * valid one
+ */
+ListFileWriter::ListFileWriter(const char *fileName, std::uint32_t elementSize,
+  std::uint32_t elementAlignment)
+: m_pFile(std::fopen(fileName, "wb")),
+  m_fileName(fileName),
+  m_position(0)
+{
+  if (! m_pFile) {
+    throwError("fopen");
+  }
+
+  std::memset(&m_header, 0, sizeof(m_header));
+  m_header.m_elementSize = elementSize;
+  m_header.m_elementAlignment = elementAlignment;
+  try {
+    writeBytes(&m_header, sizeof(m_header));
+    pad(elementAlignment);
+  }
+  catch (...) {
+    std::fclose(m_pFile);
+    throw;
+  }
+  m_header.m_payloadOffset = m_position;
+}
+
+ListFileWriter::~ListFileWriter()
+{
+  if (m_pFile) {
+    std::fclose(m_pFile);
+  }
+}
+
+void ListFileWriter::writeBytes(const void *pBytes, std::size_t size)
+{
+  if (size == 0) {
+    return;
+  }
+  if (std::fwrite(pBytes, 1, size, m_pFile) != size) {
+    throwError("fwrite");
+  }
+  m_position += size;
+}
+
+std::uint64_t ListFileWriter::position() const
+{
+  return m_position;
+}
+
+/**
+ * Write the offset table if there is one, then the header, and close the file
+ */
+void ListFileWriter::finish(std::uint64_t count, const std::vector<std::uint64_t> *pTable)
+{
+  if (pTable) {
+    pad(alignof(std::uint64_t));
+    m_header.m_tableOffset = m_position;
+    writeBytes(pTable->data(), pTable->size() * sizeof(std::uint64_t));
+  }
+
+  std::memcpy(m_header.m_magic, s_magic, sizeof(s_magic));
+  m_header.m_version = s_version;
+  m_header.m_count = count;
+  if (std::fseek(m_pFile, 0, SEEK_SET) != 0) {
+    throwError("fseek");
+  }
+  writeBytes(&m_header, sizeof(m_header));
+
+  std::FILE *pFile = m_pFile;
+  m_pFile = 0;
+  if (std::fclose(pFile) != 0) {
+    throwError("fclose");
+  }
+}
+
+void ListFileWriter::pad(std::size_t alignment)
+{
+  static const char zeros[64] = {};
+  while (m_position % alignment != 0) {
+    std::size_t size = alignment - m_position % alignment;
+    writeBytes(zeros, size < sizeof(zeros) ? size : sizeof(zeros));
+  }
+}
+
+void ListFileWriter::throwError(const char *operation)
+{
+  throw std::runtime_error(std::string(operation) + " failed for " + m_fileName);
+}
+
+/**
+ * Check that the header and the layout it describes fit the file, and return the header
+ */
+const ListFileHeader &checkListFile(const MappedFile &file, std::uint32_t elementSize,
+  std::uint32_t elementAlignment, const char *fileName)
+{
+  if (file.size() < sizeof(ListFileHeader)) {
+    throwFormatError(fileName, "not a list file");
+  }
+  const ListFileHeader &header = *reinterpret_cast<const ListFileHeader *>(file.data());
+  if (std::memcmp(header.m_magic, s_magic, sizeof(s_magic)) != 0) {
+    throwFormatError(fileName, "not a list file");
+  }
+  if (header.m_version != s_version) {
+    throwFormatError(fileName, "unsupported list file version");
+  }
+  if (header.m_elementSize != elementSize || header.m_elementAlignment != elementAlignment) {
+    throwFormatError(fileName, "list file of another element type");
+  }
+
+  std::uint64_t size = file.size();
+  if (header.m_payloadOffset < sizeof(ListFileHeader) || header.m_payloadOffset > size) {
+    throwFormatError(fileName, "truncated list file");
+  }
+  if (elementSize != 0) {
+    if (header.m_payloadOffset % header.m_elementAlignment != 0
+      || header.m_count > (size - header.m_payloadOffset) / elementSize) {
+      throwFormatError(fileName, "truncated list file");
+    }
+  }
+  else {
+    if (header.m_tableOffset < header.m_payloadOffset || header.m_tableOffset > size
+      || header.m_tableOffset % alignof(std::uint64_t) != 0
+      || header.m_count > (size - header.m_tableOffset) / sizeof(std::uint64_t)) {
+      throwFormatError(fileName, "truncated list file");
+    }
+  }
+  if (header.m_count > std::numeric_limits<std::size_t>::max()) {
+    throwFormatError(fileName, "list file too large");
+  }
+  return header;
+}
+
+ListWriter<std::string>::ListWriter(const char *fileName)
+: ListFileWriter(fileName, 0, 1)
+{}
+
+void ListWriter<std::string>::write(std::string_view value)
+{
+  if (value.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::length_error("ListWriter::write: string too long");
+  }
+
+  // Reserve the table entry first, so that a failure leaves the writer consistent
+  m_recordOffsets.push_back(position());
+  std::uint32_t length = static_cast<std::uint32_t>(value.size());
+  writeBytes(&length, s_recordLengthSize);
+  writeBytes(value.data(), value.size());
+}
+
+void ListWriter<std::string>::finish()
+{
+  ListFileWriter::finish(m_recordOffsets.size(), &m_recordOffsets);
+}
+
+MappedList<std::string>::MappedList(const char *fileName)
+: m_file(fileName),
+  m_pFirstRecord(0),
+  m_pEndRecord(0),
+  m_pRecordOffsets(0),
+  m_count(0)
+{
+  const ListFileHeader &header = checkListFile(m_file, 0, 1, fileName);
+  m_pFirstRecord = m_file.data() + header.m_payloadOffset;
+  m_pRecordOffsets = reinterpret_cast<const std::uint64_t *>(m_file.data() + header.m_tableOffset);
+  m_count = static_cast<std::size_t>(header.m_count);
+
+  // The records end where the last one does, before the padding of the table
+  m_pEndRecord = m_pFirstRecord;
+  if (m_count > 0) {
+    const char *pLastRecord = checkedRecord(m_pRecordOffsets[m_count - 1], fileName);
+    m_pEndRecord = pLastRecord + s_recordLengthSize + recordValue(pLastRecord).size();
+  }
+}
+
+/**
+ * Throws std::out_of_range if the list is shorter, std::runtime_error if the table entry of the
+ * record is corrupt
+ */
+std::string_view MappedList<std::string>::at(std::size_t position) const
+{
+  if (position >= m_count) {
+    throw std::out_of_range("MappedList::at");
+  }
+  return recordValue(checkedRecord(m_pRecordOffsets[position], "MappedList::at"));
+}
+
+/**
+ * Return the record at offset, after checking that it lies, length prefix and characters
+ * included, between the payload and the offset table
+ */
+const char *MappedList<std::string>::checkedRecord(std::uint64_t offset, const char *context) const
+{
+  std::uint64_t payloadOffset = m_pFirstRecord - m_file.data();
+  std::uint64_t tableOffset = reinterpret_cast<const char *>(m_pRecordOffsets) - m_file.data();
+  if (offset < payloadOffset || offset > tableOffset
+    || tableOffset - offset < s_recordLengthSize
+    || recordValue(m_file.data() + offset).size() > tableOffset - offset - s_recordLengthSize) {
+    throwFormatError(context, "record offset out of range");
+  }
+  return m_file.data() + offset;
+}
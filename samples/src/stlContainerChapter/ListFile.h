@@ -0,0 +1,443 @@
+/**
+ * Binary file format for lists, written by ListWriter and read in place by MappedList
+ *   - elements are stored in list order, after a fixed-size header. Lists of trivially copyable
+ *     values store them contiguously, suitably aligned. Lists of strings store each string as a
+ *     length-prefixed record, followed by a table of record offsets for positional access
+ *   - the writer streams elements to the file: Only the offset table of string lists is kept in
+ *     memory until finish() writes it, along with the header
+ *   - MappedList maps the file into memory and iterates it in place. Opening a list does not
+ *     depend on its size and does not allocate per element: Pages are only read when touched
+ *   - integers are stored in host byte order; a file written on a host of the other byte order is
+ *     rejected as an unsupported version
+ *   - errors are reported by throwing std::runtime_error. Opening a file checks the header, and
+ *     that the last record lies between the payload and the offset table. at() checks the record
+ *     it reads the same way. Iterators check that each record they read ends before the last
+ *     one does, in constant time, so that a corrupt length is never followed out of the mapping
+ */
+
+#ifndef LISTFILE_H
+#define LISTFILE_H
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+struct ListFileHeader {
+  char m_magic[4];
+  std::uint32_t m_version;
+  // sizeof(T) for lists of trivially copyable values, 0 for lists of strings
+  std::uint32_t m_elementSize;
+  std::uint32_t m_elementAlignment;
+  std::uint64_t m_count;
+  // Offsets from the beginning of the file. The table only exists for lists of strings
+  std::uint64_t m_payloadOffset;
+  std::uint64_t m_tableOffset;
+};
+
+/**
+ * Untyped part of ListWriter: The file, the header and padding
+ */
+class ListFileWriter {
+protected:
+  ListFileWriter(const char *fileName, std::uint32_t elementSize, std::uint32_t elementAlignment);
+  ~ListFileWriter();
+
+  void writeBytes(const void *pBytes, std::size_t size);
+  std::uint64_t position() const;
+
+  void finish(std::uint64_t count, const std::vector<std::uint64_t> *pTable);
+
+private:
+  // Not copyable
+  ListFileWriter(const ListFileWriter &rhs);
+  ListFileWriter &operator=(const ListFileWriter &rhs);
+
+  void pad(std::size_t alignment);
+  void throwError(const char *operation);
+
+  std::FILE *m_pFile;
+  std::string m_fileName;
+  ListFileHeader m_header;
+  std::uint64_t m_position;
+};
+
+const ListFileHeader &checkListFile(const MappedFile &file, std::uint32_t elementSize,
+  std::uint32_t elementAlignment, const char *fileName);
+
+/**
+ * Write a list of trivially copyable values. The file is only valid once finish() returned
+ */
+template<class T>
+class ListWriter : private ListFileWriter {
+public:
+  static_assert(std::is_trivially_copyable<T>::value,
+    "Only lists of trivially copyable values or strings can be written");
+
+  explicit ListWriter(const char *fileName);
+
+  void write(const T &value);
+  template<class InputIterator>
+  void write(InputIterator first, InputIterator last);
+
+  void finish();
+
+private:
+  std::uint64_t m_count;
+};
+
+/**
+ * Write a list of strings. The file is only valid once finish() returned
+ */
+template<>
+class ListWriter<std::string> : private ListFileWriter {
+public:
+  explicit ListWriter(const char *fileName);
+
+  void write(std::string_view value);
+  template<class InputIterator>
+  void write(InputIterator first, InputIterator last);
+
+  void finish();
+
+private:
+  std::vector<std::uint64_t> m_recordOffsets;
+};
+
+/**
+ * Read-only view of a list of trivially copyable values stored in a file
+ */
+template<class T>
+class MappedList {
+public:
+  class ConstIterator {
+  public:
+    ConstIterator();
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const T *operator->() const;
+    const T &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pValue == rhs.m_pValue;
+    }
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pValue != rhs.m_pValue;
+    }
+
+  private:
+    friend class MappedList;
+
+    explicit ConstIterator(const T *pValue);
+
+    const T *m_pValue;
+  };
+
+  explicit MappedList(const char *fileName);
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  std::size_t size() const;
+  const T &at(std::size_t position) const;
+
+private:
+  // Not copyable
+  MappedList(const MappedList &rhs);
+  MappedList &operator=(const MappedList &rhs);
+
+  MappedFile m_file;
+  const T *m_pFirstValue;
+  std::size_t m_count;
+};
+
+/**
+ * Read-only view of a list of strings stored in a file. Values are exposed as std::string_view,
+ * pointing into the mapped file
+ */
+template<>
+class MappedList<std::string> {
+private:
+  // Since values are not stored as objects, operator-> returns this proxy
+  class ValuePointer {
+  public:
+    explicit ValuePointer(std::string_view value);
+
+    const std::string_view *operator->() const;
+
+  private:
+    std::string_view m_value;
+  };
+
+public:
+  class ConstIterator {
+  public:
+    ConstIterator();
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    ValuePointer operator->() const;
+    std::string_view operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pRecord == rhs.m_pRecord;
+    }
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pRecord != rhs.m_pRecord;
+    }
+
+  private:
+    friend class MappedList;
+
+    ConstIterator(const char *pRecord, const char *pEndRecord);
+
+    const char *m_pRecord;
+    // End of the records, which the record read must not cross
+    const char *m_pEndRecord;
+  };
+
+  explicit MappedList(const char *fileName);
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  std::size_t size() const;
+  std::string_view at(std::size_t position) const;
+
+private:
+  // Not copyable
+  MappedList(const MappedList &rhs);
+  MappedList &operator=(const MappedList &rhs);
+
+  static std::string_view recordValue(const char *pRecord);
+  static std::string_view checkedRecordValue(const char *pRecord, const char *pEndRecord);
+  const char *checkedRecord(std::uint64_t offset, const char *context) const;
+
+  MappedFile m_file;
+  const char *m_pFirstRecord;
+  const char *m_pEndRecord;
+  const std::uint64_t *m_pRecordOffsets;
+  std::size_t m_count;
+};
+
+// Size of the length prefix of string records
+const std::size_t s_recordLengthSize = sizeof(std::uint32_t);
+
+template<class T>
+ListWriter<T>::ListWriter(const char *fileName)
+: ListFileWriter(fileName, sizeof(T), alignof(T)),
+  m_count(0)
+{}
+
+template<class T>
+void ListWriter<T>::write(const T &value)
+{
+  writeBytes(&value, sizeof(T));
+  ++m_count;
+}
+
+template<class T>
+template<class InputIterator>
+void ListWriter<T>::write(InputIterator first, InputIterator last)
+{
+  for (; first != last; ++first) {
+    write(*first);
+  }
+}
+
+template<class T>
+void ListWriter<T>::finish()
+{
+  ListFileWriter::finish(m_count, 0);
+}
+
+template<class InputIterator>
+void ListWriter<std::string>::write(InputIterator first, InputIterator last)
+{
+  for (; first != last; ++first) {
+    write(*first);
+  }
+}
+
+template<class T>
+MappedList<T>::ConstIterator::ConstIterator()
+: m_pValue(0)
+{}
+
+template<class T>
+typename MappedList<T>::ConstIterator &MappedList<T>::ConstIterator::operator++()
+{
+  ++m_pValue;
+  return *this;
+}
+
+template<class T>
+const typename MappedList<T>::ConstIterator MappedList<T>::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  ++m_pValue;
+  return tmp;
+}
+
+template<class T>
+const T *MappedList<T>::ConstIterator::operator->() const
+{
+  return m_pValue;
+}
+
+template<class T>
+const T &MappedList<T>::ConstIterator::operator*() const
+{
+  return *m_pValue;
+}
+
+template<class T>
+MappedList<T>::ConstIterator::ConstIterator(const T *pValue)
+: m_pValue(pValue)
+{}
+
+template<class T>
+MappedList<T>::MappedList(const char *fileName)
+: m_file(fileName),
+  m_pFirstValue(0),
+  m_count(0)
+{
+  const ListFileHeader &header = checkListFile(m_file, sizeof(T), alignof(T), fileName);
+  m_pFirstValue = reinterpret_cast<const T *>(m_file.data() + header.m_payloadOffset);
+  m_count = static_cast<std::size_t>(header.m_count);
+}
+
+template<class T>
+typename MappedList<T>::ConstIterator MappedList<T>::begin() const
+{
+  return ConstIterator(m_pFirstValue);
+}
+
+template<class T>
+typename MappedList<T>::ConstIterator MappedList<T>::end() const
+{
+  return ConstIterator(m_pFirstValue + m_count);
+}
+
+template<class T>
+std::size_t MappedList<T>::size() const
+{
+  return m_count;
+}
+
+/**
+ * Throws std::out_of_range if the list is shorter
+ */
+template<class T>
+const T &MappedList<T>::at(std::size_t position) const
+{
+  if (position >= m_count) {
+    throw std::out_of_range("MappedList::at");
+  }
+  return m_pFirstValue[position];
+}
+
+/**
+ * Records are not aligned, so the length prefix is copied out rather than read in place
+ */
+inline std::string_view MappedList<std::string>::recordValue(const char *pRecord)
+{
+  std::uint32_t length;
+  std::memcpy(&length, pRecord, s_recordLengthSize);
+  return std::string_view(pRecord + s_recordLengthSize, length);
+}
+
+/**
+ * Return the value of the record, after checking that it ends before pEndRecord. Throws
+ * std::runtime_error otherwise
+ */
+inline std::string_view MappedList<std::string>::checkedRecordValue(const char *pRecord,
+  const char *pEndRecord)
+{
+  std::size_t size = static_cast<std::size_t>(pEndRecord - pRecord);
+  if (size < s_recordLengthSize) {
+    throw std::runtime_error("MappedList: record length out of range");
+  }
+  std::string_view value = recordValue(pRecord);
+  if (value.size() > size - s_recordLengthSize) {
+    throw std::runtime_error("MappedList: record length out of range");
+  }
+  return value;
+}
+
+inline MappedList<std::string>::ValuePointer::ValuePointer(std::string_view value)
+: m_value(value)
+{}
+
+inline const std::string_view *MappedList<std::string>::ValuePointer::operator->() const
+{
+  return &m_value;
+}
+
+inline MappedList<std::string>::ConstIterator::ConstIterator()
+: m_pRecord(0),
+  m_pEndRecord(0)
+{}
+
+inline MappedList<std::string>::ConstIterator &
+MappedList<std::string>::ConstIterator::operator++()
+{
+  m_pRecord += s_recordLengthSize + checkedRecordValue(m_pRecord, m_pEndRecord).size();
+  return *this;
+}
+
+inline const MappedList<std::string>::ConstIterator
+MappedList<std::string>::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+inline MappedList<std::string>::ValuePointer
+MappedList<std::string>::ConstIterator::operator->() const
+{
+  return ValuePointer(checkedRecordValue(m_pRecord, m_pEndRecord));
+}
+
+inline std::string_view MappedList<std::string>::ConstIterator::operator*() const
+{
+  return checkedRecordValue(m_pRecord, m_pEndRecord);
+}
+
+inline MappedList<std::string>::ConstIterator::ConstIterator(const char *pRecord,
+  const char *pEndRecord)
+: m_pRecord(pRecord),
+  m_pEndRecord(pEndRecord)
+{}
+
+inline MappedList<std::string>::ConstIterator MappedList<std::string>::begin() const
+{
+  return ConstIterator(m_pFirstRecord, m_pEndRecord);
+}
+
+inline MappedList<std::string>::ConstIterator MappedList<std::string>::end() const
+{
+  return ConstIterator(m_pEndRecord, m_pEndRecord);
+}
+
+inline std::size_t MappedList<std::string>::size() const
+{
+  return m_count;
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include "ListStats.h"
+
+#include <cstdio>
+
+CountingListStats::Counters CountingListStats::s_counters;
+
+namespace {
+
+void printLatencies(const char *operation, const unsigned long long *latencies)
+{
+  for (std::size_t i = 0; i < s_latencyBucketCount; ++i) {
+    if (latencies[i] != 0) {
+      std::printf("%-8s < %12llu ns %12llu\n", operation, 2ULL << i, latencies[i]);
+    }
+  }
+}
+
+}
+
+void printListStats(const ListStatsSnapshot &snapshot)
+{
+  std::printf("node allocations %12llu\n", snapshot.m_nodeAllocations);
+  std::printf("node frees       %12llu\n", snapshot.m_nodeFrees);
+  std::printf("copies           %12llu\n", snapshot.m_copies);
+  std::printf("releases         %12llu\n", snapshot.m_releases);
+  std::printf("traversals       %12llu\n", snapshot.m_traversals);
+  std::printf("traversal steps  %12llu\n", snapshot.m_traversalSteps);
+  std::printf("peak length      %12llu\n", snapshot.m_peakLength);
+  printLatencies("copy", snapshot.m_copyLatencies);
+  printLatencies("release", snapshot.m_releaseLatencies);
+}
+
+/**
+ * Counters are read one by one while lists may still be updating them, so a snapshot taken
+ * concurrently is not exactly consistent
+ */
+ListStatsSnapshot CountingListStats::snapshot()
+{
+  ListStatsSnapshot snapshot;
+  snapshot.m_nodeAllocations = s_counters.m_nodeAllocations.load(std::memory_order_relaxed);
+  snapshot.m_nodeFrees = s_counters.m_nodeFrees.load(std::memory_order_relaxed);
+  snapshot.m_copies = s_counters.m_copies.load(std::memory_order_relaxed);
+  snapshot.m_releases = s_counters.m_releases.load(std::memory_order_relaxed);
+  snapshot.m_traversals = s_counters.m_traversals.load(std::memory_order_relaxed);
+  snapshot.m_traversalSteps = s_counters.m_traversalSteps.load(std::memory_order_relaxed);
+  snapshot.m_peakLength = s_counters.m_peakLength.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < s_latencyBucketCount; ++i) {
+    snapshot.m_copyLatencies[i] = s_counters.m_copyLatencies[i].load(std::memory_order_relaxed);
+    snapshot.m_releaseLatencies[i]
+      = s_counters.m_releaseLatencies[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+/**
+ * Reset all counters. The lengths of the existing lists are kept, but the peak length only
+ * accounts for them again once they grow
+ */
+void CountingListStats::reset()
+{
+  s_counters.m_nodeAllocations.store(0, std::memory_order_relaxed);
+  s_counters.m_nodeFrees.store(0, std::memory_order_relaxed);
+  s_counters.m_copies.store(0, std::memory_order_relaxed);
+  s_counters.m_releases.store(0, std::memory_order_relaxed);
+  s_counters.m_traversals.store(0, std::memory_order_relaxed);
+  s_counters.m_traversalSteps.store(0, std::memory_order_relaxed);
+  s_counters.m_peakLength.store(0, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < s_latencyBucketCount; ++i) {
+    s_counters.m_copyLatencies[i].store(0, std::memory_order_relaxed);
+    s_counters.m_releaseLatencies[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void CountingListStats::recordLatency(std::atomic<unsigned long long> *latencies,
+  const Stopwatch &stopwatch)
+{
+  unsigned long long nanoseconds = stopwatch.elapsedNanoseconds();
+  std::size_t bucket = 0;
+  for (; nanoseconds > 1 && bucket < s_latencyBucketCount - 1; nanoseconds >>= 1) {
+    ++bucket;
+  }
+  latencies[bucket].fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,237 @@
+/**
+ * Statistics policies for the list samples
+ *   - a list inherits privately from its policy, and calls its hooks when nodes are created,
+ *     destroyed or moved between lists, and when the list is traversed, copied or released
+ *   - NoListStats does nothing: It has no data, so as an empty base it takes no room, and its
+ *     hooks are empty inline functions which compile to nothing. They are also constant
+ *     expressions, so that lists using it can be evaluated at compile time
+ *   - CountingListStats counts node allocations and frees, copies, releases, traversals (calls
+ *     to begin()) and iterator steps, keeps the peak length reached by any list, and histograms of
+ *     the latencies of copies and releases. The counters are process-wide and updated with relaxed
+ *     atomic operations, so that lists used by different threads can be instrumented. snapshot()
+ *     exports them
+ *   - the default policy is chosen at compile time: CountingListStats if LIST_STATS is defined to
+ *     1, NoListStats otherwise
+ */
+
+#ifndef LISTSTATS_H
+#define LISTSTATS_H
+
+#include "ListConstexpr.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#ifndef LIST_STATS
+#define LIST_STATS 0
+#endif
+
+// Latencies are counted in buckets of powers of 2: Bucket i holds latencies in [2^i, 2^(i+1))
+// nanoseconds. The first bucket also holds shorter latencies, and the last one longer ones
+const std::size_t s_latencyBucketCount = 32;
+
+struct ListStatsSnapshot {
+  unsigned long long m_nodeAllocations;
+  unsigned long long m_nodeFrees;
+  unsigned long long m_copies;
+  unsigned long long m_releases;
+  unsigned long long m_traversals;
+  unsigned long long m_traversalSteps;
+  unsigned long long m_peakLength;
+  unsigned long long m_copyLatencies[s_latencyBucketCount];
+  unsigned long long m_releaseLatencies[s_latencyBucketCount];
+};
+
+void printListStats(const ListStatsSnapshot &snapshot);
+
+class NoListStats {
+public:
+  class Stopwatch {
+  };
+
+  LIST_CONSTEXPR void nodeCreated();
+  LIST_CONSTEXPR void nodeDestroyed();
+  LIST_CONSTEXPR void allNodesDestroyed();
+  LIST_CONSTEXPR void nodesMoved(NoListStats &from, std::size_t count);
+  LIST_CONSTEXPR void allNodesMoved(NoListStats &from);
+
+  static LIST_CONSTEXPR void traversalStarted();
+  static LIST_CONSTEXPR void traversalStep();
+  static LIST_CONSTEXPR void copied(const Stopwatch &stopwatch);
+  static LIST_CONSTEXPR void released(const Stopwatch &stopwatch);
+};
+
+class CountingListStats {
+public:
+  // Measures the time elapsed since its construction
+  class Stopwatch {
+  public:
+    Stopwatch();
+
+    unsigned long long elapsedNanoseconds() const;
+
+  private:
+    std::chrono::steady_clock::time_point m_startTime;
+  };
+
+  CountingListStats();
+
+  void nodeCreated();
+  void nodeDestroyed();
+  void allNodesDestroyed();
+  void nodesMoved(CountingListStats &from, std::size_t count);
+  void allNodesMoved(CountingListStats &from);
+
+  static void traversalStarted();
+  static void traversalStep();
+  static void copied(const Stopwatch &stopwatch);
+  static void released(const Stopwatch &stopwatch);
+
+  static ListStatsSnapshot snapshot();
+  static void reset();
+
+private:
+  struct Counters {
+    std::atomic<unsigned long long> m_nodeAllocations;
+    std::atomic<unsigned long long> m_nodeFrees;
+    std::atomic<unsigned long long> m_copies;
+    std::atomic<unsigned long long> m_releases;
+    std::atomic<unsigned long long> m_traversals;
+    std::atomic<unsigned long long> m_traversalSteps;
+    std::atomic<unsigned long long> m_peakLength;
+    std::atomic<unsigned long long> m_copyLatencies[s_latencyBucketCount];
+    std::atomic<unsigned long long> m_releaseLatencies[s_latencyBucketCount];
+  };
+
+  // Not copyable: The length belongs to a single list
+  CountingListStats(const CountingListStats &rhs);
+  CountingListStats &operator=(const CountingListStats &rhs);
+
+  void lengthIncreased(std::size_t count);
+  static void recordLatency(std::atomic<unsigned long long> *latencies,
+    const Stopwatch &stopwatch);
+
+  static Counters s_counters;
+
+  // Length of the list
+  std::size_t m_length;
+};
+
+#if LIST_STATS
+typedef CountingListStats DefaultListStats;
+#else
+typedef NoListStats DefaultListStats;
+#endif
+
+LIST_CONSTEXPR void NoListStats::nodeCreated()
+{}
+
+LIST_CONSTEXPR void NoListStats::nodeDestroyed()
+{}
+
+LIST_CONSTEXPR void NoListStats::allNodesDestroyed()
+{}
+
+LIST_CONSTEXPR void NoListStats::nodesMoved(NoListStats &/*from*/, std::size_t /*count*/)
+{}
+
+LIST_CONSTEXPR void NoListStats::allNodesMoved(NoListStats &/*from*/)
+{}
+
+LIST_CONSTEXPR void NoListStats::traversalStarted()
+{}
+
+LIST_CONSTEXPR void NoListStats::traversalStep()
+{}
+
+LIST_CONSTEXPR void NoListStats::copied(const Stopwatch &/*stopwatch*/)
+{}
+
+LIST_CONSTEXPR void NoListStats::released(const Stopwatch &/*stopwatch*/)
+{}
+
+inline CountingListStats::Stopwatch::Stopwatch()
+: m_startTime(std::chrono::steady_clock::now())
+{}
+
+inline unsigned long long CountingListStats::Stopwatch::elapsedNanoseconds() const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+inline CountingListStats::CountingListStats()
+: m_length(0)
+{}
+
+inline void CountingListStats::nodeCreated()
+{
+  s_counters.m_nodeAllocations.fetch_add(1, std::memory_order_relaxed);
+  lengthIncreased(1);
+}
+
+inline void CountingListStats::nodeDestroyed()
+{
+  s_counters.m_nodeFrees.fetch_add(1, std::memory_order_relaxed);
+  --m_length;
+}
+
+/**
+ * All nodes of the list were destroyed at once
+ */
+inline void CountingListStats::allNodesDestroyed()
+{
+  if (m_length != 0) {
+    s_counters.m_nodeFrees.fetch_add(m_length, std::memory_order_relaxed);
+    m_length = 0;
+  }
+}
+
+/**
+ * count nodes were moved from the list of from (which may be this one) to this list
+ */
+inline void CountingListStats::nodesMoved(CountingListStats &from, std::size_t count)
+{
+  from.m_length -= count;
+  lengthIncreased(count);
+}
+
+inline void CountingListStats::allNodesMoved(CountingListStats &from)
+{
+  nodesMoved(from, from.m_length);
+}
+
+inline void CountingListStats::traversalStarted()
+{
+  s_counters.m_traversals.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingListStats::traversalStep()
+{
+  s_counters.m_traversalSteps.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingListStats::copied(const Stopwatch &stopwatch)
+{
+  s_counters.m_copies.fetch_add(1, std::memory_order_relaxed);
+  recordLatency(s_counters.m_copyLatencies, stopwatch);
+}
+
+inline void CountingListStats::released(const Stopwatch &stopwatch)
+{
+  s_counters.m_releases.fetch_add(1, std::memory_order_relaxed);
+  recordLatency(s_counters.m_releaseLatencies, stopwatch);
+}
+
+inline void CountingListStats::lengthIncreased(std::size_t count)
+{
+  m_length += count;
+  unsigned long long peakLength = s_counters.m_peakLength.load(std::memory_order_relaxed);
+  while (m_length > peakLength
+    && ! s_counters.m_peakLength.compare_exchange_weak(peakLength, m_length,
+      std::memory_order_relaxed)) {
+  }
+}
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * Flat tables computed at compile time from lists (C++20)
+ *   - fill is a function object which takes a list by reference and pushes, sorts or merges the
+ *     elements of the table into it. It is called in constant evaluation, on a list which is
+ *     destroyed before the evaluation ends
+ *   - listTableSize() runs fill once to size the table. makeListTable() runs it again and copies
+ *     the elements into a std::array, in list order. Both can initialize constexpr variables: The
+ *     table is then computed by the compiler and stored in read-only data, with no work left for
+ *     program startup
+ *   - elements must be default constructible and copy assignable in constant evaluation, such as
+ *     integers or std::string_view referring to string literals
+ *
+ * Usage:
+ *   constexpr auto fill = [](List<int> &list) { ... };
+ *   constexpr auto s_table = makeListTable<List<int>, listTableSize<List<int> >(fill)>(fill);
+ */
+
+#ifndef LISTTABLE_H
+#define LISTTABLE_H
+
+#include "ListConstexpr.h"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template<class ListType, class Fill>
+constexpr std::size_t listTableSize(Fill fill)
+{
+  ListType list;
+  fill(list);
+  std::size_t size = 0;
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    ++size;
+  }
+  return size;
+}
+
+/**
+ * Throws std::length_error, which fails the compilation in constant evaluation, if the list
+ * filled does not have Size elements
+ */
+template<class ListType, std::size_t Size, class Fill>
+constexpr auto makeListTable(Fill fill)
+{
+  typedef std::remove_cvref_t<decltype(*std::declval<const ListType &>().begin())> ValueType;
+
+  ListType list;
+  fill(list);
+  std::array<ValueType, Size> table{};
+  std::size_t i = 0;
+  for (auto it = list.begin(); it != list.end(); ++it, ++i) {
+    if (i == Size) {
+      throw std::length_error("makeListTable");
+    }
+    table[i] = *it;
+  }
+  if (i != Size) {
+    throw std::length_error("makeListTable");
+  }
+  return table;
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+void throwError(const char *operation, const char *fileName)
+{
+  throw std::runtime_error(std::string(operation) + " failed for " + fileName);
+}
+
+}
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const char *fileName)
+: m_pData(0),
+  m_size(0)
+{
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, 0);
+  if (file == INVALID_HANDLE_VALUE) {
+    throwError("CreateFile", fileName);
+  }
+
+  LARGE_INTEGER size;
+  if (! GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throwError("GetFileSizeEx", fileName);
+  }
+  m_size = static_cast<std::size_t>(size.QuadPart);
+
+  // Empty files cannot be mapped
+  if (m_size == 0) {
+    CloseHandle(file);
+    return;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+  CloseHandle(file);
+  if (! mapping) {
+    throwError("CreateFileMapping", fileName);
+  }
+
+  // The view keeps the mapping alive
+  m_pData = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  CloseHandle(mapping);
+  if (! m_pData) {
+    throwError("MapViewOfFile", fileName);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_pData) {
+    UnmapViewOfFile(m_pData);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const char *fileName)
+: m_pData(0),
+  m_size(0)
+{
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    throwError("open", fileName);
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    close(fd);
+    throwError("fstat", fileName);
+  }
+  m_size = static_cast<std::size_t>(status.st_size);
+
+  // Empty files cannot be mapped
+  if (m_size == 0) {
+    close(fd);
+    return;
+  }
+
+  // The mapping remains valid once the file is closed
+  void *pData = mmap(0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (pData == MAP_FAILED) {
+    throwError("mmap", fileName);
+  }
+  m_pData = static_cast<const char *>(pData);
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_pData) {
+    munmap(const_cast<char *>(m_pData), m_size);
+  }
+}
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * Read-only memory mapping of a whole file
+ *   - the file contents are paged in on demand by the operating system, so opening a file costs
+ *     the same whatever its size
+ *   - errors are reported by throwing std::runtime_error
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+class MappedFile {
+public:
+  explicit MappedFile(const char *fileName);
+  ~MappedFile();
+
+  const char *data() const;
+  std::size_t size() const;
+
+private:
+  // Not copyable
+  MappedFile(const MappedFile &rhs);
+  MappedFile &operator=(const MappedFile &rhs);
+
+  const char *m_pData;
+  std::size_t m_size;
+};
+
+inline const char *MappedFile::data() const
+{
+  return m_pData;
+}
+
+inline std::size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+#endif
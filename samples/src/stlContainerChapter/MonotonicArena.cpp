@@ -0,0 +1,86 @@
+#include "MonotonicArena.h"
+
+#include <new>
+
+namespace {
+
+// Size of a block header, rounded up so that block data is suitably aligned for any type
+const std::size_t s_headerSize = (sizeof(void *) + sizeof(std::size_t) + alignof(std::max_align_t) - 1)
+  / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+}
+
+MonotonicArena::MonotonicArena(std::size_t blockSize)
+: m_blockSize(blockSize),
+  m_pFirstBlock(0),
+  m_pCurrentBlock(0),
+  m_pNextByte(0),
+  m_pBlockEnd(0)
+{}
+
+MonotonicArena::~MonotonicArena()
+{
+  release();
+}
+
+/**
+ * Make all memory available again. Blocks are kept for reuse, only the allocation position is
+ * moved back to the beginning of the first block
+ */
+void MonotonicArena::reset()
+{
+  if (m_pFirstBlock) {
+    useBlock(m_pFirstBlock);
+  }
+}
+
+/**
+ * Give all blocks back to the global heap
+ */
+void MonotonicArena::release()
+{
+  Block *pBlock = m_pFirstBlock;
+  while (pBlock) {
+    Block *pNextBlock = pBlock->m_pNextBlock;
+    ::operator delete(pBlock);
+    pBlock = pNextBlock;
+  }
+  m_pFirstBlock = 0;
+  m_pCurrentBlock = 0;
+  m_pNextByte = 0;
+  m_pBlockEnd = 0;
+}
+
+/**
+ * Slow path of allocate(): The current block is exhausted. Continue with the next block if it is
+ * large enough, otherwise insert a new one (oversized if needed) after the current block
+ */
+void *MonotonicArena::allocateFromNextBlock(std::size_t size, std::size_t alignment)
+{
+  std::size_t requiredSize = size + alignment - 1;
+
+  Block *pNextBlock = m_pCurrentBlock ? m_pCurrentBlock->m_pNextBlock : m_pFirstBlock;
+  if (! pNextBlock || pNextBlock->m_size < requiredSize) {
+    std::size_t blockSize = requiredSize > m_blockSize ? requiredSize : m_blockSize;
+    Block *pBlock = static_cast<Block *>(::operator new(s_headerSize + blockSize));
+    pBlock->m_pNextBlock = pNextBlock;
+    pBlock->m_size = blockSize;
+    if (m_pCurrentBlock) {
+      m_pCurrentBlock->m_pNextBlock = pBlock;
+    }
+    else {
+      m_pFirstBlock = pBlock;
+    }
+    pNextBlock = pBlock;
+  }
+
+  useBlock(pNextBlock);
+  return allocate(size, alignment);
+}
+
+void MonotonicArena::useBlock(Block *pBlock)
+{
+  m_pCurrentBlock = pBlock;
+  m_pNextByte = reinterpret_cast<char *>(pBlock) + s_headerSize;
+  m_pBlockEnd = m_pNextByte + pBlock->m_size;
+}
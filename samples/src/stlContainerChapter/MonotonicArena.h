@@ -0,0 +1,62 @@
+/**
+ * Monotonic arena
+ *   - memory is handed out by bumping a pointer within large blocks
+ *   - individual allocations are never freed. Instead, the whole arena is reset at once, in
+ *     constant time, after which its blocks are reused
+ *   - not thread-safe. The arena must outlive all objects allocated from it, and their destructors
+ *     (if any) must have run before it is reset
+ */
+
+#ifndef MONOTONICARENA_H
+#define MONOTONICARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+class MonotonicArena {
+public:
+  explicit MonotonicArena(std::size_t blockSize = 64 * 1024);
+  ~MonotonicArena();
+
+  void *allocate(std::size_t size, std::size_t alignment);
+
+  void reset();
+  void release();
+
+private:
+  // Header stored at the beginning of each block
+  struct Block {
+    Block *m_pNextBlock;
+    std::size_t m_size;
+  };
+
+  // Not copyable
+  MonotonicArena(const MonotonicArena &rhs);
+  MonotonicArena &operator=(const MonotonicArena &rhs);
+
+  void *allocateFromNextBlock(std::size_t size, std::size_t alignment);
+  void useBlock(Block *pBlock);
+
+  std::size_t m_blockSize;
+
+  // Blocks are kept in allocation order, so that they are reused in the same order after a reset
+  Block *m_pFirstBlock;
+  Block *m_pCurrentBlock;
+
+  char *m_pNextByte;
+  char *m_pBlockEnd;
+};
+
+inline void *MonotonicArena::allocate(std::size_t size, std::size_t alignment)
+{
+  std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(m_pNextByte) + alignment - 1) & ~(alignment - 1);
+  if (address + size <= reinterpret_cast<std::uintptr_t>(m_pBlockEnd)) {
+    m_pNextByte = reinterpret_cast<char *>(address + size);
+    return reinterpret_cast<void *>(address);
+  }
+  else {
+    return allocateFromNextBlock(size, alignment);
+  }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "NodePool.h"
+
+#include <cassert>
+#include <new>
+
+namespace {
+
+// Alignment suitable for any node type. Chunk headers and node sizes are rounded up to it
+const std::size_t s_alignment = alignof(std::max_align_t);
+
+std::size_t alignedSize(std::size_t size)
+{
+  return (size + s_alignment - 1) / s_alignment * s_alignment;
+}
+
+}
+
+NodePool::NodePool(std::size_t nodeSize, std::size_t nodesPerChunk)
+: m_nodeSize(alignedSize(nodeSize < sizeof(FreeNode) ? sizeof(FreeNode) : nodeSize)),
+  m_nodesPerChunk(nodesPerChunk),
+  m_pFirstChunk(0),
+  m_pFirstFreeNode(0),
+  m_pNextUncarvedNode(0),
+  m_pChunkEnd(0)
+{
+  assert(nodesPerChunk != 0);
+}
+
+NodePool::~NodePool()
+{
+  release();
+}
+
+/**
+ * Give all chunks back to the global heap at once. Nodes still in use become invalid, the
+ * objects they contain must therefore have been destroyed beforehand
+ */
+void NodePool::release()
+{
+  Chunk *pChunk = m_pFirstChunk;
+  while (pChunk) {
+    Chunk *pNextChunk = pChunk->m_pNextChunk;
+    ::operator delete(pChunk);
+    pChunk = pNextChunk;
+  }
+  m_pFirstChunk = 0;
+  m_pFirstFreeNode = 0;
+  m_pNextUncarvedNode = 0;
+  m_pChunkEnd = 0;
+}
+
+/**
+ * Slow path of allocate(): The free list is empty and the current chunk is exhausted
+ */
+void *NodePool::allocateFromNewChunk()
+{
+  const std::size_t headerSize = alignedSize(sizeof(Chunk));
+  char *pStorage = static_cast<char *>(::operator new(headerSize + m_nodesPerChunk * m_nodeSize));
+
+  Chunk *pChunk = reinterpret_cast<Chunk *>(pStorage);
+  pChunk->m_pNextChunk = m_pFirstChunk;
+  m_pFirstChunk = pChunk;
+
+  char *pFirstNode = pStorage + headerSize;
+  m_pNextUncarvedNode = pFirstNode + m_nodeSize;
+  m_pChunkEnd = pFirstNode + m_nodesPerChunk * m_nodeSize;
+  return pFirstNode;
+}
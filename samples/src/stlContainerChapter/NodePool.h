@@ -0,0 +1,87 @@
+/**
+ * Pool of fixed-size nodes
+ *   - nodes are carved from large chunks, so that the global heap is only hit once per chunk
+ *   - freed nodes are put on an intrusive free list and reused by subsequent allocations
+ *   - all chunks are released in bulk, either explicitly or when the pool is destroyed
+ * The pool only deals with raw storage. Constructing and destroying the objects living in it
+ * is the responsibility of the client
+ */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+
+class NodePool {
+public:
+  NodePool(std::size_t nodeSize, std::size_t nodesPerChunk);
+  ~NodePool();
+
+  void *allocate();
+  void deallocate(void *pNode);
+
+  void release();
+
+  std::size_t nodesPerChunk() const;
+
+private:
+  // Free nodes are linked through their own storage
+  struct FreeNode {
+    FreeNode *m_pNextFreeNode;
+  };
+
+  // Header stored at the beginning of each chunk
+  struct Chunk {
+    Chunk *m_pNextChunk;
+  };
+
+  // Not copyable
+  NodePool(const NodePool &rhs);
+  NodePool &operator=(const NodePool &rhs);
+
+  void *allocateFromNewChunk();
+
+  std::size_t m_nodeSize;
+  std::size_t m_nodesPerChunk;
+
+  Chunk *m_pFirstChunk;
+  FreeNode *m_pFirstFreeNode;
+
+  // Nodes of the most recent chunk are carved lazily, so that a new chunk does not need to be
+  // threaded onto the free list
+  char *m_pNextUncarvedNode;
+  char *m_pChunkEnd;
+};
+
+inline void *NodePool::allocate()
+{
+  // Recycle freed nodes first
+  if (m_pFirstFreeNode) {
+    FreeNode *pNode = m_pFirstFreeNode;
+    m_pFirstFreeNode = pNode->m_pNextFreeNode;
+    return pNode;
+  }
+  // Carve the next node from the current chunk
+  else if (m_pNextUncarvedNode != m_pChunkEnd) {
+    void *pNode = m_pNextUncarvedNode;
+    m_pNextUncarvedNode += m_nodeSize;
+    return pNode;
+  }
+  else {
+    return allocateFromNewChunk();
+  }
+}
+
+inline void NodePool::deallocate(void *pNode)
+{
+  FreeNode *pFreeNode = static_cast<FreeNode *>(pNode);
+  pFreeNode->m_pNextFreeNode = m_pFirstFreeNode;
+  m_pFirstFreeNode = pFreeNode;
+}
+
+inline std::size_t NodePool::nodesPerChunk() const
+{
+  return m_nodesPerChunk;
+}
+
+#endif
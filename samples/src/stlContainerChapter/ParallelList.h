@@ -0,0 +1,253 @@
+/**
+ * Parallel algorithms over lists
+ *   - a list only offers forward iterators, so a serial pass first records split points every
+ *     segmentLength elements (ListPartition). A partition can be kept and reused by several
+ *     algorithms, as long as the list is not modified in between. Since this pass is serial,
+ *     reusing a partition is what lets repeated scans scale with the number of threads
+ *   - segments are then processed by a set of threads, each claiming the next unprocessed segment
+ *     from a shared counter. Segments are small and numerous compared to the number of threads,
+ *     so that threads which finish early keep taking work from the others
+ *   - parallel_reduce() requires an associative operation. Results of the segments are combined
+ *     in list order, so the operation need not be commutative
+ *   - the first exception thrown by a function object is rethrown once all threads are done
+ *   - works with any container or range providing forward iterators
+ */
+
+#ifndef PARALLELLIST_H
+#define PARALLELLIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Long enough for the cost of claiming a segment to be negligible, short enough for load
+// balancing on lists of a few hundred thousand elements
+const std::size_t s_defaultSegmentLength = 16 * 1024;
+
+template<class ForwardIterator>
+class ListPartition {
+public:
+  ListPartition(ForwardIterator first, ForwardIterator last,
+    std::size_t segmentLength = s_defaultSegmentLength);
+
+  std::size_t segmentCount() const;
+  ForwardIterator segmentBegin(std::size_t segment) const;
+  ForwardIterator segmentEnd(std::size_t segment) const;
+
+private:
+  // Beginning of each segment, followed by the end of the range
+  std::vector<ForwardIterator> m_splitPoints;
+};
+
+/**
+ * A segmentLength of 0 is taken as 1
+ */
+template<class ForwardIterator>
+ListPartition<ForwardIterator>::ListPartition(ForwardIterator first, ForwardIterator last,
+  std::size_t segmentLength)
+{
+  if (segmentLength == 0) {
+    segmentLength = 1;
+  }
+
+  std::size_t length = 0;
+  for (; first != last; ++first, ++length) {
+    if (length % segmentLength == 0) {
+      m_splitPoints.push_back(first);
+    }
+  }
+  m_splitPoints.push_back(last);
+}
+
+template<class ForwardIterator>
+std::size_t ListPartition<ForwardIterator>::segmentCount() const
+{
+  return m_splitPoints.size() - 1;
+}
+
+template<class ForwardIterator>
+ForwardIterator ListPartition<ForwardIterator>::segmentBegin(std::size_t segment) const
+{
+  return m_splitPoints[segment];
+}
+
+template<class ForwardIterator>
+ForwardIterator ListPartition<ForwardIterator>::segmentEnd(std::size_t segment) const
+{
+  return m_splitPoints[segment + 1];
+}
+
+/**
+ * Number of threads used when none is specified: One per hardware thread
+ */
+inline std::size_t defaultThreadCount()
+{
+  unsigned int threadCount = std::thread::hardware_concurrency();
+  return threadCount ? threadCount : 1;
+}
+
+/**
+ * Call task(segment) once for each segment in [0, segmentCount), on threadCount threads
+ * including the calling one
+ */
+template<class Task>
+void runSegments(std::size_t segmentCount, std::size_t threadCount, Task &task)
+{
+  std::atomic<std::size_t> nextSegment(0);
+  std::exception_ptr pException;
+  std::mutex exceptionMutex;
+
+  auto work = [&]() {
+    try {
+      for (std::size_t segment = nextSegment++; segment < segmentCount; segment = nextSegment++) {
+        task(segment);
+      }
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (! pException) {
+        pException = std::current_exception();
+      }
+      // Let the other threads run out of segments
+      nextSegment = segmentCount;
+    }
+  };
+
+  if (threadCount == 0) {
+    threadCount = defaultThreadCount();
+  }
+  if (threadCount > segmentCount) {
+    threadCount = segmentCount;
+  }
+
+  // Reserved first, so that adding a thread never reallocates. Whatever fails, the threads already
+  // started are joined below, and the calling thread works along with them
+  std::vector<std::thread> threads;
+  try {
+    if (threadCount > 1) {
+      threads.reserve(threadCount - 1);
+    }
+    for (std::size_t i = 1; i < threadCount; ++i) {
+      threads.emplace_back(work);
+    }
+  }
+  catch (...) {
+    // Out of threads or memory: Make do with the ones already started
+  }
+  work();
+  for (std::size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  if (pException) {
+    std::rethrow_exception(pException);
+  }
+}
+
+/**
+ * Call function on each element. The order of the calls is unspecified
+ */
+template<class ForwardIterator, class Function>
+void parallel_for_each(const ListPartition<ForwardIterator> &partition, Function function,
+  std::size_t threadCount = 0)
+{
+  auto task = [&](std::size_t segment) {
+    ForwardIterator last = partition.segmentEnd(segment);
+    for (ForwardIterator it = partition.segmentBegin(segment); it != last; ++it) {
+      function(*it);
+    }
+  };
+  runSegments(partition.segmentCount(), threadCount, task);
+}
+
+template<class ForwardIterator, class Function>
+void parallel_for_each(ForwardIterator first, ForwardIterator last, Function function,
+  std::size_t threadCount = 0)
+{
+  parallel_for_each(ListPartition<ForwardIterator>(first, last), function, threadCount);
+}
+
+/**
+ * Combine init and all elements with operation, which must be associative
+ */
+template<class ForwardIterator, class T, class BinaryOperation>
+T parallel_reduce(const ListPartition<ForwardIterator> &partition, T init,
+  BinaryOperation operation, std::size_t threadCount = 0)
+{
+  // Wrapped so that std::vector<bool> is never used: Its elements cannot be written concurrently
+  struct Result {
+    T m_value;
+  };
+
+  // Segments are never empty, so each one is reduced starting from its first element
+  std::vector<Result> results;
+  results.reserve(partition.segmentCount());
+  for (std::size_t segment = 0; segment < partition.segmentCount(); ++segment) {
+    Result result = { *partition.segmentBegin(segment) };
+    results.push_back(result);
+  }
+
+  auto task = [&](std::size_t segment) {
+    T value = results[segment].m_value;
+    ForwardIterator it = partition.segmentBegin(segment);
+    ForwardIterator last = partition.segmentEnd(segment);
+    for (++it; it != last; ++it) {
+      value = operation(value, *it);
+    }
+    results[segment].m_value = value;
+  };
+  runSegments(partition.segmentCount(), threadCount, task);
+
+  for (std::size_t segment = 0; segment < results.size(); ++segment) {
+    init = operation(init, results[segment].m_value);
+  }
+  return init;
+}
+
+template<class ForwardIterator, class T, class BinaryOperation>
+T parallel_reduce(ForwardIterator first, ForwardIterator last, T init, BinaryOperation operation,
+  std::size_t threadCount = 0)
+{
+  return parallel_reduce(ListPartition<ForwardIterator>(first, last), init, operation,
+    threadCount);
+}
+
+/**
+ * Count the elements for which predicate returns true
+ */
+template<class ForwardIterator, class Predicate>
+std::size_t parallel_count_if(const ListPartition<ForwardIterator> &partition,
+  Predicate predicate, std::size_t threadCount = 0)
+{
+  std::vector<std::size_t> counts(partition.segmentCount());
+
+  auto task = [&](std::size_t segment) {
+    std::size_t count = 0;
+    ForwardIterator last = partition.segmentEnd(segment);
+    for (ForwardIterator it = partition.segmentBegin(segment); it != last; ++it) {
+      if (predicate(*it)) {
+        ++count;
+      }
+    }
+    counts[segment] = count;
+  };
+  runSegments(partition.segmentCount(), threadCount, task);
+
+  std::size_t count = 0;
+  for (std::size_t segment = 0; segment < counts.size(); ++segment) {
+    count += counts[segment];
+  }
+  return count;
+}
+
+template<class ForwardIterator, class Predicate>
+std::size_t parallel_count_if(ForwardIterator first, ForwardIterator last, Predicate predicate,
+  std::size_t threadCount = 0)
+{
+  return parallel_count_if(ListPartition<ForwardIterator>(first, last), predicate, threadCount);
+}
+
+#endif
@@ -0,0 +1,452 @@
+/**
+ * Implementation of a list container
+ *   - does not conform to the STL conventions
+ *   - friend iterator comparison operators
+ *   - persistent nodes: nodes are reference counted and shared between lists. Since the list
+ *     only grows at the front, a copy simply shares all nodes of the original, and push_front
+ *     shares the existing nodes as the tail of the new one. Copy and push_front are O(1)
+ *   - copy-on-write: a node is cloned when it is reached through an Iterator (which allows
+ *     mutation) while shared. Iterating with a ConstIterator never copies anything
+ *   - copying a list shares the nodes an Iterator already reached. Each copy made from a list
+ *     is therefore counted, and an Iterator taken before the last one walks again from the front
+ *     at its next use, cloning the shared nodes up to its own. Until then, it compares different
+ *     from iterators taken after the copy
+ *   - reference counts are atomic or not, depending on the policy. With AtomicRefCount, lists
+ *     sharing nodes may be used (and destroyed) from different threads, as long as each list
+ *     object is only used by one thread at a time
+ */
+
+#ifndef LIST_H
+#define LIST_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * Reference count for lists used by a single thread
+ */
+class NonAtomicRefCount {
+public:
+  NonAtomicRefCount();
+
+  void increment();
+  // Return true when the last reference was released
+  bool decrement();
+  bool isShared() const;
+
+private:
+  std::size_t m_count;
+};
+
+/**
+ * Reference count for lists whose nodes are shared between threads
+ */
+class AtomicRefCount {
+public:
+  AtomicRefCount();
+
+  void increment();
+  // Return true when the last reference was released
+  bool decrement();
+  bool isShared() const;
+
+private:
+  std::atomic<std::size_t> m_count;
+};
+
+template<class T, class R = NonAtomicRefCount>
+class List {
+private:
+  struct Node;
+
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const T *operator->() const;
+    const T &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pNode == rhs.m_pNode;
+    }
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pNode != rhs.m_pNode;
+    }
+
+  private:
+    friend class List;
+
+    explicit ConstIterator(const Node *);
+
+    const Node *m_pNode;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    T *operator->() const;
+    T &operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pNode == rhs.m_pNode;
+    }
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pNode != rhs.m_pNode;
+    }
+
+  private:
+    friend class List;
+    friend class ConstIterator;
+
+    Iterator(List *pList, Node *pNode);
+
+    void unshareFromFront() const;
+
+    List *m_pList;
+    // Mutable, since the iterator may move to a clone of its node before giving access to it
+    mutable Node *m_pNode;
+    // Number of copies made from the list when m_pNode was last known not to be shared
+    mutable std::size_t m_copyCount;
+  };
+
+  List();
+
+  List(const List &rhs);
+  List &operator=(const List &rhs);
+
+  ~List();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(const T &value);
+
+private:
+  static void unshare(Node *&pNode);
+
+  static Node *acquire(Node *pNode);
+  static void release(Node *pNode);
+
+  Node *m_pFirstNode;
+  // Copies made from the list, so that iterators notice their nodes may have become shared
+  mutable std::size_t m_copyCount;
+};
+
+inline NonAtomicRefCount::NonAtomicRefCount()
+: m_count(1)
+{}
+
+inline void NonAtomicRefCount::increment()
+{
+  ++m_count;
+}
+
+inline bool NonAtomicRefCount::decrement()
+{
+  return --m_count == 0;
+}
+
+inline bool NonAtomicRefCount::isShared() const
+{
+  return m_count != 1;
+}
+
+inline AtomicRefCount::AtomicRefCount()
+: m_count(1)
+{}
+
+/**
+ * A new reference is always made from an existing one, so no ordering is needed
+ */
+inline void AtomicRefCount::increment()
+{
+  m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Releasing a reference publishes the changes made through it. The thread releasing the last
+ * reference acquires them all before the node is destroyed
+ */
+inline bool AtomicRefCount::decrement()
+{
+  return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+/**
+ * If the count is 1, the caller holds the only reference, and nobody else can create a new one
+ */
+inline bool AtomicRefCount::isShared() const
+{
+  return m_count.load(std::memory_order_acquire) != 1;
+}
+
+template<class T, class R>
+struct List<T, R>::Node {
+  Node(const T &value, Node *pNextNode);
+
+  T m_value;
+  // Owns a reference to the next node
+  Node *m_pNextNode;
+  R m_refCount;
+};
+
+template<class T, class R>
+List<T, R>::Node::Node(const T &value, Node *pNextNode)
+: m_value(value),
+  m_pNextNode(pNextNode)
+{}
+
+template<class T, class R>
+List<T, R>::ConstIterator::ConstIterator()
+: m_pNode(0)
+{}
+
+template<class T, class R>
+List<T, R>::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pNode(rhs.m_pNode)
+{}
+
+template<class T, class R>
+typename List<T, R>::ConstIterator &List<T, R>::ConstIterator::operator++()
+{
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+template<class T, class R>
+const typename List<T, R>::ConstIterator List<T, R>::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  m_pNode = m_pNode->m_pNextNode;
+  return tmp;
+}
+
+template<class T, class R>
+const T *List<T, R>::ConstIterator::operator->() const
+{
+  return &m_pNode->m_value;
+}
+
+template<class T, class R>
+const T &List<T, R>::ConstIterator::operator*() const
+{
+  return m_pNode->m_value;
+}
+
+template<class T, class R>
+List<T, R>::ConstIterator::ConstIterator(const Node *pNode)
+: m_pNode(pNode)
+{}
+
+template<class T, class R>
+List<T, R>::Iterator::Iterator()
+: m_pList(0),
+  m_pNode(0),
+  m_copyCount(0)
+{}
+
+/**
+ * The node the iterator moves to is cloned if it is shared. Since the current node is not, the
+ * list is then the only one to reach it
+ */
+template<class T, class R>
+typename List<T, R>::Iterator &List<T, R>::Iterator::operator++()
+{
+  unshareFromFront();
+  unshare(m_pNode->m_pNextNode);
+  m_pNode = m_pNode->m_pNextNode;
+  return *this;
+}
+
+template<class T, class R>
+const typename List<T, R>::Iterator List<T, R>::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template<class T, class R>
+T *List<T, R>::Iterator::operator->() const
+{
+  unshareFromFront();
+  return &m_pNode->m_value;
+}
+
+template<class T, class R>
+T &List<T, R>::Iterator::operator*() const
+{
+  unshareFromFront();
+  return m_pNode->m_value;
+}
+
+template<class T, class R>
+List<T, R>::Iterator::Iterator(List *pList, Node *pNode)
+: m_pList(pList),
+  m_pNode(pNode),
+  m_copyCount(pList->m_copyCount)
+{}
+
+/**
+ * If the list was copied since the iterator last checked its node, the nodes up to it may be
+ * shared with the copy. They are then walked from the front of the list and cloned if they are,
+ * each from the link of a node which is not, and the iterator moves to the clone of its own.
+ * O(position) once per copy, nothing otherwise
+ */
+template<class T, class R>
+void List<T, R>::Iterator::unshareFromFront() const
+{
+  if (! m_pList || m_copyCount == m_pList->m_copyCount) {
+    return;
+  }
+
+  if (m_pNode) {
+    Node **ppNode = &m_pList->m_pFirstNode;
+    while (*ppNode != m_pNode) {
+      // The iterator must point into the list
+      assert(*ppNode != 0);
+      unshare(*ppNode);
+      ppNode = &(*ppNode)->m_pNextNode;
+    }
+    unshare(*ppNode);
+    m_pNode = *ppNode;
+  }
+  m_copyCount = m_pList->m_copyCount;
+}
+
+template<class T, class R>
+List<T, R>::List()
+: m_pFirstNode(0),
+  m_copyCount(0)
+{}
+
+/**
+ * O(1): All nodes are shared with rhs
+ */
+template<class T, class R>
+List<T, R>::List(const List<T, R> &rhs)
+: m_pFirstNode(acquire(rhs.m_pFirstNode)),
+  m_copyCount(0)
+{
+  ++rhs.m_copyCount;
+}
+
+/**
+ * Iterators into the list are invalidated
+ */
+template<class T, class R>
+List<T, R> &List<T, R>::operator=(const List<T, R> &rhs)
+{
+  // Acquire first, so that self-assignment is harmless
+  Node *pFirstNode = acquire(rhs.m_pFirstNode);
+  release(m_pFirstNode);
+  m_pFirstNode = pFirstNode;
+  ++rhs.m_copyCount;
+  return *this;
+}
+
+template<class T, class R>
+List<T, R>::~List()
+{
+  release(m_pFirstNode);
+}
+
+template<class T, class R>
+typename List<T, R>::ConstIterator List<T, R>::begin() const
+{
+  return ConstIterator(m_pFirstNode);
+}
+
+/**
+ * The first node is cloned if it is shared, and so is every node the iterator reaches
+ */
+template<class T, class R>
+typename List<T, R>::Iterator List<T, R>::begin()
+{
+  unshare(m_pFirstNode);
+  return Iterator(this, m_pFirstNode);
+}
+
+template<class T, class R>
+typename List<T, R>::ConstIterator List<T, R>::end() const
+{
+  return ConstIterator(0);
+}
+
+template<class T, class R>
+typename List<T, R>::Iterator List<T, R>::end()
+{
+  return Iterator(this, 0);
+}
+
+/**
+ * O(1): The reference of the list to its first node is handed over to the new node
+ */
+template<class T, class R>
+void List<T, R>::push_front(const T &value)
+{
+  m_pFirstNode = new Node(value, m_pFirstNode);
+}
+
+/**
+ * If the node referenced by pNode (the first node pointer of a list, or the link of a node which
+ * is not shared) is shared, replace it by a copy only referenced by pNode. The copy shares the
+ * rest of the chain
+ */
+template<class T, class R>
+void List<T, R>::unshare(Node *&pNode)
+{
+  if (! pNode || ! pNode->m_refCount.isShared()) {
+    return;
+  }
+
+  Node *pCopy = new Node(pNode->m_value, 0);
+  pCopy->m_pNextNode = acquire(pNode->m_pNextNode);
+  release(pNode);
+  pNode = pCopy;
+}
+
+template<class T, class R>
+typename List<T, R>::Node *List<T, R>::acquire(Node *pNode)
+{
+  if (pNode) {
+    pNode->m_refCount.increment();
+  }
+  return pNode;
+}
+
+/**
+ * Release a reference to pNode. Nodes whose last reference goes away are destroyed, which
+ * releases their reference to the next node. This is done iteratively, so that long chains
+ * cannot overflow the stack
+ */
+template<class T, class R>
+void List<T, R>::release(Node *pNode)
+{
+  while (pNode && pNode->m_refCount.decrement()) {
+    Node *pNextNode = pNode->m_pNextNode;
+    delete pNode;
+    pNode = pNextNode;
+  }
+}
+
+#endif
@@ -5,6 +5,8 @@
 // Include for std::allocator
 #include <memory>
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 // Two choices:
 // 1) Include <iterator>, derive each iterator class from std::iterator publicly
@@ -15,12 +17,27 @@
 //    since no disambiguation needed for iterator (<iterator> also needed since forward_iterator_tag is defined there)
 // We may choose between 1) and 2) since (see TC++PL, p. 553: "CAN be used to define those member types")
 
-template<class T, class A = std::allocator<T> >
+// Tail tracking policies, for the third template parameter of List:
+//   - NoTailTracking: only the first node is known. Nothing is stored in addition, but push_back,
+//     append and size are not available
+//   - TailTracking: the last node and the number of elements are maintained as well, which makes
+//     push_back, append and size O(1) at the price of two more words per list
+struct NoTailTracking {};
+struct TailTracking {};
+
+template<class T, class A = std::allocator<T>, class P = NoTailTracking>
 class List {
 private:
   struct Node;
 
+  // Nodes are allocated through the allocator rebound to the node type, so that the element
+  // and its link share a single allocation served by A (and not by the global operator new)
+  typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAllocator;
+  typedef std::allocator_traits<NodeAllocator> NodeAllocatorTraits;
+
 public:
+  typedef A allocator_type;
+
   typedef typename A::value_type value_type;
   typedef typename A::size_type size_type;
   typedef typename A::difference_type difference_type;
@@ -35,15 +52,15 @@ public:
 
   // Method 2): Derive from std::iterator; No prefixing needed here, value_type from class above, i.e. List. But maybe better to be explicit (more readable)? 
   class const_iterator : public std::iterator<
-    typename List<T, A>::value_type,
-    typename List<T, A>::difference_type,
-    typename List<T, A>::const_pointer,
-    typename List<T, A>::const_reference
+    typename List<T, A, P>::value_type,
+    typename List<T, A, P>::difference_type,
+    typename List<T, A, P>::const_pointer,
+    typename List<T, A, P>::const_reference
   > {
   public:
     const_iterator();
     // Disambiguation needed here!
-    const_iterator(const typename List<T, A>::iterator &rhs);
+    const_iterator(const typename List<T, A, P>::iterator &rhs);
 
     const_iterator &operator++();
     const const_iterator operator++(int);
@@ -71,10 +88,10 @@ public:
   // Method 2): Derive from std::iterator; No prefixing needed here, value_type from class above, i.e. List. But here added since more
   // readable / explicit
   class iterator : public std::iterator<
-    typename List<T, A>::value_type,
-    typename List<T, A>::difference_type,
-    typename List<T, A>::pointer,
-    typename List<T, A>::reference
+    typename List<T, A, P>::value_type,
+    typename List<T, A, P>::difference_type,
+    typename List<T, A, P>::pointer,
+    typename List<T, A, P>::reference
   > {
   public:
     iterator();
@@ -104,10 +121,14 @@ public:
   };
 
   List();
+  explicit List(const A &allocator);
   
   List(const List &rhs);
   List &operator=(const List &rhs);
 
+  List(List &&rhs) noexcept;
+  List &operator=(List &&rhs);
+
   ~List();
 
   const_iterator begin() const;
@@ -117,207 +138,545 @@ public:
   iterator end();
 
   void push_front(const T &value);
+  void push_front(T &&value);
+
+  template<class... Args>
+  void emplace_front(Args &&... args);
+
+  // Only available with the TailTracking policy
+  void push_back(const T &value);
+  void push_back(T &&value);
+
+  template<class... Args>
+  void emplace_back(Args &&... args);
+
+  void append(List &&other);
+
+  size_type size() const;
+
+  allocator_type get_allocator() const;
 
 private:
   void createFrom(const List &rhs);
+  void moveFrom(List &rhs);
   void release();
 
-  Node *m_pFirstNode;
+  template<class... Args>
+  Node *createNode(Node *pNextNode, Args &&... args);
+  void destroyNode(Node *pNode);
+
+  void assignAllocator(const List &rhs, std::true_type);
+  void assignAllocator(const List &rhs, std::false_type);
+
+  void moveAssign(List &rhs, std::true_type);
+  void moveAssign(List &rhs, std::false_type);
+
+  NodeAllocator &nodeAllocator();
+  const NodeAllocator &nodeAllocator() const;
+
+  // State maintained besides the first node, depending on the tail policy. The functions are
+  // notified of every change made to the node chain
+  template<class Policy, class Dummy = void>
+  struct TailState {
+    void pushedFront(Node *) {}
+    void assigned(Node *, size_type) {}
+    void takeOver(TailState &) {}
+  };
+
+  template<class Dummy>
+  struct TailState<TailTracking, Dummy> {
+    TailState() : m_pLastNode(0), m_size(0) {}
+
+    void pushedFront(Node *pNode)
+    {
+      if (! m_pLastNode) {
+        m_pLastNode = pNode;
+      }
+      ++m_size;
+    }
+    void assigned(Node *pLastNode, size_type size)
+    {
+      m_pLastNode = pLastNode;
+      m_size = size;
+    }
+    void takeOver(TailState &rhs)
+    {
+      assigned(rhs.m_pLastNode, rhs.m_size);
+      rhs.assigned(0, 0);
+    }
+
+    Node *m_pLastNode;
+    size_type m_size;
+  };
+
+  // The node allocator and the tail state are stored as base classes of the structure holding
+  // the first node, so that they take no space when empty (as std::allocator and NoTailTracking)
+  struct Impl : public NodeAllocator, public TailState<P> {
+    explicit Impl(const NodeAllocator &allocator);
+    explicit Impl(NodeAllocator &&allocator);
+
+    Node *m_pFirstNode;
+  };
+
+  Impl m_impl;
 };
 
-template<class T, class A>
-struct List<T, A>::Node {
-  Node(const T &value, Node *pNextNode);
+template<class T, class A, class P>
+struct List<T, A, P>::Node {
+  // The value is constructed in place from any arguments T accepts
+  template<class... Args>
+  explicit Node(Node *pNextNode, Args &&... args);
 
   T m_value;
   Node *m_pNextNode;
 };
 
-template<class T, class A>
-List<T, A>::Node::Node(const T &value, Node *pNextNode)
-: m_value(value),
+template<class T, class A, class P>
+template<class... Args>
+List<T, A, P>::Node::Node(Node *pNextNode, Args &&... args)
+: m_value(std::forward<Args>(args)...),
   m_pNextNode(pNextNode)
 {}
 
-template<class T, class A>
-List<T, A>::const_iterator::const_iterator()
+template<class T, class A, class P>
+List<T, A, P>::const_iterator::const_iterator()
 : m_pNode(0)
 {}
 
-template<class T, class A>
-List<T, A>::const_iterator::const_iterator(const typename List<T, A>::iterator &rhs)
+template<class T, class A, class P>
+List<T, A, P>::const_iterator::const_iterator(const typename List<T, A, P>::iterator &rhs)
 : m_pNode(rhs.m_pNode)
 {}
 
-template<class T, class A>
-typename List<T, A>::const_iterator &List<T, A>::const_iterator::operator++()
+template<class T, class A, class P>
+typename List<T, A, P>::const_iterator &List<T, A, P>::const_iterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
   return *this;
 }
 
-template<class T, class A>
-const typename List<T, A>::const_iterator List<T, A>::const_iterator::operator++(int)
+template<class T, class A, class P>
+const typename List<T, A, P>::const_iterator List<T, A, P>::const_iterator::operator++(int)
 {
   const_iterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
   return tmp;
 }
 
-template<class T, class A>
-const T *List<T, A>::const_iterator::operator->() const
+template<class T, class A, class P>
+const T *List<T, A, P>::const_iterator::operator->() const
 {
   return &m_pNode->m_value;
 }
 
-template<class T, class A>
-const T &List<T, A>::const_iterator::operator*() const
+template<class T, class A, class P>
+const T &List<T, A, P>::const_iterator::operator*() const
 {
   return m_pNode->m_value;
 }
 
-template<class T, class A>
-List<T, A>::const_iterator::const_iterator(const Node *pNode)
+template<class T, class A, class P>
+List<T, A, P>::const_iterator::const_iterator(const Node *pNode)
 : m_pNode(pNode)
 {}
 
-template<class T, class A>
-List<T, A>::iterator::iterator()
+template<class T, class A, class P>
+List<T, A, P>::iterator::iterator()
 : m_pNode(0)
 {}
 
-template<class T, class A>
-typename List<T, A>::iterator &List<T, A>::iterator::operator++()
+template<class T, class A, class P>
+typename List<T, A, P>::iterator &List<T, A, P>::iterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
   return *this;
 }
 
-template<class T, class A>
-const typename List<T, A>::iterator List<T, A>::iterator::operator++(int)
+template<class T, class A, class P>
+const typename List<T, A, P>::iterator List<T, A, P>::iterator::operator++(int)
 {
   iterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
   return tmp;
 }
 
-template<class T, class A>
-T *List<T, A>::iterator::operator->() const
+template<class T, class A, class P>
+T *List<T, A, P>::iterator::operator->() const
 {
   return &m_pNode->m_value;
 }
 
-template<class T, class A>
-T &List<T, A>::iterator::operator*() const
+template<class T, class A, class P>
+T &List<T, A, P>::iterator::operator*() const
 {
   return m_pNode->m_value;
 }
 
-template<class T, class A>
-List<T, A>::iterator::iterator(Node *pNode)
+template<class T, class A, class P>
+List<T, A, P>::iterator::iterator(Node *pNode)
 : m_pNode(pNode)
 {}
 
-template<class T, class A>
-List<T, A>::List()
-: m_pFirstNode(0)
+template<class T, class A, class P>
+List<T, A, P>::Impl::Impl(const NodeAllocator &allocator)
+: NodeAllocator(allocator),
+  m_pFirstNode(0)
+{}
+
+template<class T, class A, class P>
+List<T, A, P>::Impl::Impl(NodeAllocator &&allocator)
+: NodeAllocator(std::move(allocator)),
+  m_pFirstNode(0)
+{}
+
+template<class T, class A, class P>
+List<T, A, P>::List()
+: m_impl(NodeAllocator())
+{}
+
+template<class T, class A, class P>
+List<T, A, P>::List(const A &allocator)
+: m_impl(NodeAllocator(allocator))
 {}
 
-template<class T, class A>
-List<T, A>::List(const List<T, A> &rhs)
-: m_pFirstNode(0)
+template<class T, class A, class P>
+List<T, A, P>::List(const List<T, A, P> &rhs)
+: m_impl(NodeAllocatorTraits::select_on_container_copy_construction(rhs.nodeAllocator()))
 {
   createFrom(rhs);
 }
 
-template<class T, class A>
-List<T, A> &List<T, A>::operator=(const List<T, A> &rhs)
+template<class T, class A, class P>
+List<T, A, P> &List<T, A, P>::operator=(const List<T, A, P> &rhs)
 {
   // Check for self-assignment
   if (this != &rhs) {
+    // Nodes must be released with the allocator which created them, before it is possibly replaced
     release();
+    assignAllocator(rhs, typename NodeAllocatorTraits::propagate_on_container_copy_assignment());
     createFrom(rhs);
   }
   return *this;
 }
 
-template<class T, class A>
-List<T, A>::~List()
+/**
+ * Steal the nodes of the right-hand side, which is left empty
+ */
+template<class T, class A, class P>
+List<T, A, P>::List(List<T, A, P> &&rhs) noexcept
+: m_impl(std::move(rhs.nodeAllocator()))
+{
+  m_impl.m_pFirstNode = rhs.m_impl.m_pFirstNode;
+  m_impl.takeOver(rhs.m_impl);
+  rhs.m_impl.m_pFirstNode = 0;
+}
+
+template<class T, class A, class P>
+List<T, A, P> &List<T, A, P>::operator=(List<T, A, P> &&rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    moveAssign(rhs, typename NodeAllocatorTraits::propagate_on_container_move_assignment());
+  }
+  return *this;
+}
+
+template<class T, class A, class P>
+List<T, A, P>::~List()
 {
   release();
 }
 
-template<class T, class A>
-typename List<T, A>::const_iterator List<T, A>::begin() const
+template<class T, class A, class P>
+typename List<T, A, P>::const_iterator List<T, A, P>::begin() const
 {
-  return const_iterator(m_pFirstNode);
+  return const_iterator(m_impl.m_pFirstNode);
 }
 
-template<class T, class A>
-typename List<T, A>::iterator List<T, A>::begin()
+template<class T, class A, class P>
+typename List<T, A, P>::iterator List<T, A, P>::begin()
 {
-  return iterator(m_pFirstNode);
+  return iterator(m_impl.m_pFirstNode);
 }
 
-template<class T, class A>
-typename List<T, A>::const_iterator List<T, A>::end() const
+template<class T, class A, class P>
+typename List<T, A, P>::const_iterator List<T, A, P>::end() const
 {
   return const_iterator(0);
 }
 
-template<class T, class A>
-typename List<T, A>::iterator List<T, A>::end()
+template<class T, class A, class P>
+typename List<T, A, P>::iterator List<T, A, P>::end()
 {
   return iterator(0);
 }
 
-template<class T, class A>
-void List<T, A>::push_front(const T &value)
+template<class T, class A, class P>
+void List<T, A, P>::push_front(const T &value)
+{
+  Node *pNode = createNode(m_impl.m_pFirstNode, value);
+  m_impl.m_pFirstNode = pNode;
+  m_impl.pushedFront(pNode);
+}
+
+template<class T, class A, class P>
+void List<T, A, P>::push_front(T &&value)
+{
+  Node *pNode = createNode(m_impl.m_pFirstNode, std::move(value));
+  m_impl.m_pFirstNode = pNode;
+  m_impl.pushedFront(pNode);
+}
+
+template<class T, class A, class P>
+template<class... Args>
+void List<T, A, P>::emplace_front(Args &&... args)
+{
+  Node *pNode = createNode(m_impl.m_pFirstNode, std::forward<Args>(args)...);
+  m_impl.m_pFirstNode = pNode;
+  m_impl.pushedFront(pNode);
+}
+
+template<class T, class A, class P>
+void List<T, A, P>::push_back(const T &value)
+{
+  emplace_back(value);
+}
+
+template<class T, class A, class P>
+void List<T, A, P>::push_back(T &&value)
+{
+  emplace_back(std::move(value));
+}
+
+template<class T, class A, class P>
+template<class... Args>
+void List<T, A, P>::emplace_back(Args &&... args)
+{
+  static_assert(std::is_same<P, TailTracking>::value, "Appending requires the TailTracking policy");
+
+  Node *pNode = createNode(0, std::forward<Args>(args)...);
+  if (m_impl.m_pLastNode) {
+    m_impl.m_pLastNode->m_pNextNode = pNode;
+  }
+  else {
+    m_impl.m_pFirstNode = pNode;
+  }
+  m_impl.m_pLastNode = pNode;
+  ++m_impl.m_size;
+}
+
+/**
+ * Move all elements of other to the end of the list. The nodes are relinked in O(1) if our
+ * allocator can release them, otherwise values are moved into nodes of our own
+ */
+template<class T, class A, class P>
+void List<T, A, P>::append(List<T, A, P> &&other)
+{
+  static_assert(std::is_same<P, TailTracking>::value, "Appending requires the TailTracking policy");
+
+  if (&other == this || ! other.m_impl.m_pFirstNode) {
+    return;
+  }
+
+  if (nodeAllocator() == other.nodeAllocator()) {
+    if (m_impl.m_pLastNode) {
+      m_impl.m_pLastNode->m_pNextNode = other.m_impl.m_pFirstNode;
+    }
+    else {
+      m_impl.m_pFirstNode = other.m_impl.m_pFirstNode;
+    }
+    m_impl.m_pLastNode = other.m_impl.m_pLastNode;
+    m_impl.m_size += other.m_impl.m_size;
+
+    other.m_impl.m_pFirstNode = 0;
+    other.m_impl.assigned(0, 0);
+  }
+  else {
+    for (Node *pNode = other.m_impl.m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+      emplace_back(std::move(pNode->m_value));
+    }
+    other.release();
+  }
+}
+
+template<class T, class A, class P>
+typename List<T, A, P>::size_type List<T, A, P>::size() const
+{
+  static_assert(std::is_same<P, TailTracking>::value, "size requires the TailTracking policy");
+
+  return m_impl.m_size;
+}
+
+template<class T, class A, class P>
+typename List<T, A, P>::allocator_type List<T, A, P>::get_allocator() const
 {
-  Node *pNode = new Node(value, m_pFirstNode);
-  m_pFirstNode = pNode;
+  return allocator_type(nodeAllocator());
 }
 
 /**
  * Function factoring out the code for creating a list from an existing one. Must
  * be called only on an empty list
  */
-template<class T, class A>
-void List<T, A>::createFrom(const List<T, A> &rhs)
+template<class T, class A, class P>
+void List<T, A, P>::createFrom(const List<T, A, P> &rhs)
 {
   // Ensure that the list is empty
-  assert(m_pFirstNode == 0);
+  assert(m_impl.m_pFirstNode == 0);
 
-  Node *pRhsNode = rhs.m_pFirstNode;
+  Node *pRhsNode = rhs.m_impl.m_pFirstNode;
   Node *pNode = 0;
+  size_type size = 0;
   while (pRhsNode) {
     // Empty list; create first node
-    if (! m_pFirstNode) {
-      m_pFirstNode = new Node(pRhsNode->m_value, 0);
-      pNode = m_pFirstNode;
+    if (! m_impl.m_pFirstNode) {
+      m_impl.m_pFirstNode = createNode(0, pRhsNode->m_value);
+      pNode = m_impl.m_pFirstNode;
     }
     // Add following nodes
     else {
-      pNode->m_pNextNode = new Node(pRhsNode->m_value, 0);
+      pNode->m_pNextNode = createNode(0, pRhsNode->m_value);
       pNode = pNode->m_pNextNode;
     }
     pRhsNode = pRhsNode->m_pNextNode;
+    ++size;
   }
+  m_impl.assigned(pNode, size);
+}
+
+/**
+ * Same as createFrom, but the values of rhs are moved rather than copied. rhs keeps its nodes,
+ * holding moved-from values
+ */
+template<class T, class A, class P>
+void List<T, A, P>::moveFrom(List<T, A, P> &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_impl.m_pFirstNode == 0);
+
+  Node *pNode = 0;
+  size_type size = 0;
+  for (Node *pRhsNode = rhs.m_impl.m_pFirstNode; pRhsNode; pRhsNode = pRhsNode->m_pNextNode) {
+    Node *pNewNode = createNode(0, std::move(pRhsNode->m_value));
+    if (pNode) {
+      pNode->m_pNextNode = pNewNode;
+    }
+    else {
+      m_impl.m_pFirstNode = pNewNode;
+    }
+    pNode = pNewNode;
+    ++size;
+  }
+  m_impl.assigned(pNode, size);
 }
 
 /**
  * Function factoring out the cleanup code
  */
-template<class T, class A>
-void List<T, A>::release()
+template<class T, class A, class P>
+void List<T, A, P>::release()
 {
-  Node *pNode = m_pFirstNode;
+  Node *pNode = m_impl.m_pFirstNode;
   while (pNode) {
     Node *pNextNode = pNode->m_pNextNode;
-    delete pNode;
+    destroyNode(pNode);
     pNode = pNextNode;
   }
-  m_pFirstNode = 0;
+  m_impl.m_pFirstNode = 0;
+  m_impl.assigned(0, 0);
+}
+
+/**
+ * Allocate and construct a node using the node allocator. If the value constructor throws, the
+ * storage is given back to the allocator
+ */
+template<class T, class A, class P>
+template<class... Args>
+typename List<T, A, P>::Node *List<T, A, P>::createNode(Node *pNextNode, Args &&... args)
+{
+  Node *pNode = NodeAllocatorTraits::allocate(nodeAllocator(), 1);
+  try {
+    NodeAllocatorTraits::construct(nodeAllocator(), pNode, pNextNode, std::forward<Args>(args)...);
+  }
+  catch (...) {
+    NodeAllocatorTraits::deallocate(nodeAllocator(), pNode, 1);
+    throw;
+  }
+  return pNode;
+}
+
+/**
+ * Destroy and deallocate a node created by createNode
+ */
+template<class T, class A, class P>
+void List<T, A, P>::destroyNode(Node *pNode)
+{
+  NodeAllocatorTraits::destroy(nodeAllocator(), pNode);
+  NodeAllocatorTraits::deallocate(nodeAllocator(), pNode, 1);
+}
+
+template<class T, class A, class P>
+typename List<T, A, P>::NodeAllocator &List<T, A, P>::nodeAllocator()
+{
+  return m_impl;
+}
+
+template<class T, class A, class P>
+const typename List<T, A, P>::NodeAllocator &List<T, A, P>::nodeAllocator() const
+{
+  return m_impl;
+}
+
+/**
+ * Copy assignment when the allocator propagates: Adopt the allocator of the right-hand side. Must
+ * be called only on an empty list
+ */
+template<class T, class A, class P>
+void List<T, A, P>::assignAllocator(const List<T, A, P> &rhs, std::true_type)
+{
+  assert(m_impl.m_pFirstNode == 0);
+  nodeAllocator() = rhs.nodeAllocator();
+}
+
+/**
+ * Copy assignment when the allocator does not propagate: Keep our own allocator
+ */
+template<class T, class A, class P>
+void List<T, A, P>::assignAllocator(const List<T, A, P> &/*rhs*/, std::false_type)
+{}
+
+/**
+ * Move assignment when the allocator propagates: Adopt the allocator and the nodes of the
+ * right-hand side. Must be called only on an empty list
+ */
+template<class T, class A, class P>
+void List<T, A, P>::moveAssign(List<T, A, P> &rhs, std::true_type)
+{
+  assert(m_impl.m_pFirstNode == 0);
+  nodeAllocator() = std::move(rhs.nodeAllocator());
+  m_impl.m_pFirstNode = rhs.m_impl.m_pFirstNode;
+  m_impl.takeOver(rhs.m_impl);
+  rhs.m_impl.m_pFirstNode = 0;
+}
+
+/**
+ * Move assignment when the allocator does not propagate: Nodes can only be stolen if our
+ * allocator is able to release them. Otherwise values are moved into nodes of our own. Must be
+ * called only on an empty list
+ */
+template<class T, class A, class P>
+void List<T, A, P>::moveAssign(List<T, A, P> &rhs, std::false_type)
+{
+  assert(m_impl.m_pFirstNode == 0);
+  if (nodeAllocator() == rhs.nodeAllocator()) {
+    m_impl.m_pFirstNode = rhs.m_impl.m_pFirstNode;
+    m_impl.takeOver(rhs.m_impl);
+    rhs.m_impl.m_pFirstNode = 0;
+  }
+  else {
+    moveFrom(rhs);
+    rhs.release();
+  }
 }
 
 #endif
@@ -5,6 +5,8 @@
 // Include for std::allocator
 #include <memory>
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 // Two choices:
 // 1) Include <iterator>, derive each iterator class from std::iterator publicly
@@ -20,7 +22,14 @@ class List {
 private:
   struct Node;
 
+  // Nodes are allocated through the allocator rebound to the node type, so that the element
+  // and its link share a single allocation served by A (and not by the global operator new)
+  typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAllocator;
+  typedef std::allocator_traits<NodeAllocator> NodeAllocatorTraits;
+
 public:
+  typedef A allocator_type;
+
   typedef typename A::value_type value_type;
   typedef typename A::size_type size_type;
   typedef typename A::difference_type difference_type;
@@ -107,10 +116,14 @@ public:
   };
 
   List();
+  explicit List(const A &allocator);
   
   List(const List &rhs);
   List &operator=(const List &rhs);
 
+  List(List &&rhs) noexcept;
+  List &operator=(List &&rhs);
+
   ~List();
 
   const_iterator begin() const;
@@ -120,25 +133,46 @@ public:
   iterator end();
 
   void push_front(const T &value);
+  void push_front(T &&value);
+
+  template<class... Args>
+  void emplace_front(Args &&... args);
+
+  allocator_type get_allocator() const;
 
 private:
   void createFrom(const List &rhs);
+  void moveFrom(List &rhs);
   void release();
 
+  template<class... Args>
+  Node *createNode(Node *pNextNode, Args &&... args);
+  void destroyNode(Node *pNode);
+
+  void assignAllocator(const List &rhs, std::true_type);
+  void assignAllocator(const List &rhs, std::false_type);
+
+  void moveAssign(List &rhs, std::true_type);
+  void moveAssign(List &rhs, std::false_type);
+
+  NodeAllocator m_nodeAllocator;
   Node *m_pFirstNode;
 };
 
 template<class T, class A>
 struct List<T, A>::Node {
-  Node(const T &value, Node *pNextNode);
+  // The value is constructed in place from any arguments T accepts
+  template<class... Args>
+  explicit Node(Node *pNextNode, Args &&... args);
 
   T m_value;
   Node *m_pNextNode;
 };
 
 template<class T, class A>
-List<T, A>::Node::Node(const T &value, Node *pNextNode)
-: m_value(value),
+template<class... Args>
+List<T, A>::Node::Node(Node *pNextNode, Args &&... args)
+: m_value(std::forward<Args>(args)...),
   m_pNextNode(pNextNode)
 {}
 
@@ -223,12 +257,20 @@ List<T, A>::iterator::iterator(Node *pNode)
 
 template<class T, class A>
 List<T, A>::List()
-: m_pFirstNode(0)
+: m_nodeAllocator(),
+  m_pFirstNode(0)
+{}
+
+template<class T, class A>
+List<T, A>::List(const A &allocator)
+: m_nodeAllocator(allocator),
+  m_pFirstNode(0)
 {}
 
 template<class T, class A>
 List<T, A>::List(const List<T, A> &rhs)
-: m_pFirstNode(0)
+: m_nodeAllocator(NodeAllocatorTraits::select_on_container_copy_construction(rhs.m_nodeAllocator)),
+  m_pFirstNode(0)
 {
   createFrom(rhs);
 }
@@ -238,12 +280,36 @@ List<T, A> &List<T, A>::operator=(const List<T, A> &rhs)
 {
   // Check for self-assignment
   if (this != &rhs) {
+    // Nodes must be released with the allocator which created them, before it is possibly replaced
     release();
+    assignAllocator(rhs, typename NodeAllocatorTraits::propagate_on_container_copy_assignment());
     createFrom(rhs);
   }
   return *this;
 }
 
+/**
+ * Steal the nodes of the right-hand side, which is left empty
+ */
+template<class T, class A>
+List<T, A>::List(List<T, A> &&rhs) noexcept
+: m_nodeAllocator(std::move(rhs.m_nodeAllocator)),
+  m_pFirstNode(rhs.m_pFirstNode)
+{
+  rhs.m_pFirstNode = 0;
+}
+
+template<class T, class A>
+List<T, A> &List<T, A>::operator=(List<T, A> &&rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    moveAssign(rhs, typename NodeAllocatorTraits::propagate_on_container_move_assignment());
+  }
+  return *this;
+}
+
 template<class T, class A>
 List<T, A>::~List()
 {
@@ -277,10 +343,31 @@ typename List<T, A>::iterator List<T, A>::end()
 template<class T, class A>
 void List<T, A>::push_front(const T &value)
 {
-  Node *pNode = new Node(value, m_pFirstNode);
+  Node *pNode = createNode(m_pFirstNode, value);
+  m_pFirstNode = pNode;
+}
+
+template<class T, class A>
+void List<T, A>::push_front(T &&value)
+{
+  Node *pNode = createNode(m_pFirstNode, std::move(value));
+  m_pFirstNode = pNode;
+}
+
+template<class T, class A>
+template<class... Args>
+void List<T, A>::emplace_front(Args &&... args)
+{
+  Node *pNode = createNode(m_pFirstNode, std::forward<Args>(args)...);
   m_pFirstNode = pNode;
 }
 
+template<class T, class A>
+typename List<T, A>::allocator_type List<T, A>::get_allocator() const
+{
+  return allocator_type(m_nodeAllocator);
+}
+
 /**
  * Function factoring out the code for creating a list from an existing one. Must
  * be called only on an empty list
@@ -296,18 +383,35 @@ void List<T, A>::createFrom(const List<T, A> &rhs)
   while (pRhsNode) {
     // Empty list; create first node
     if (! m_pFirstNode) {
-      m_pFirstNode = new Node(pRhsNode->m_value, 0);
+      m_pFirstNode = createNode(0, pRhsNode->m_value);
       pNode = m_pFirstNode;
     }
     // Add following nodes
     else {
-      pNode->m_pNextNode = new Node(pRhsNode->m_value, 0);
+      pNode->m_pNextNode = createNode(0, pRhsNode->m_value);
       pNode = pNode->m_pNextNode;
     }
     pRhsNode = pRhsNode->m_pNextNode;
   }
 }
 
+/**
+ * Same as createFrom, but the values of rhs are moved rather than copied. rhs keeps its nodes,
+ * holding moved-from values
+ */
+template<class T, class A>
+void List<T, A>::moveFrom(List<T, A> &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_pFirstNode == 0);
+
+  Node **ppNextNode = &m_pFirstNode;
+  for (Node *pRhsNode = rhs.m_pFirstNode; pRhsNode; pRhsNode = pRhsNode->m_pNextNode) {
+    *ppNextNode = createNode(0, std::move(pRhsNode->m_value));
+    ppNextNode = &(*ppNextNode)->m_pNextNode;
+  }
+}
+
 /**
  * Function factoring out the cleanup code
  */
@@ -317,10 +421,89 @@ void List<T, A>::release()
   Node *pNode = m_pFirstNode;
   while (pNode) {
     Node *pNextNode = pNode->m_pNextNode;
-    delete pNode;
+    destroyNode(pNode);
     pNode = pNextNode;
   }
   m_pFirstNode = 0;
 }
 
+/**
+ * Allocate and construct a node using the node allocator. If the value constructor throws, the
+ * storage is given back to the allocator
+ */
+template<class T, class A>
+template<class... Args>
+typename List<T, A>::Node *List<T, A>::createNode(Node *pNextNode, Args &&... args)
+{
+  Node *pNode = NodeAllocatorTraits::allocate(m_nodeAllocator, 1);
+  try {
+    NodeAllocatorTraits::construct(m_nodeAllocator, pNode, pNextNode, std::forward<Args>(args)...);
+  }
+  catch (...) {
+    NodeAllocatorTraits::deallocate(m_nodeAllocator, pNode, 1);
+    throw;
+  }
+  return pNode;
+}
+
+/**
+ * Destroy and deallocate a node created by createNode
+ */
+template<class T, class A>
+void List<T, A>::destroyNode(Node *pNode)
+{
+  NodeAllocatorTraits::destroy(m_nodeAllocator, pNode);
+  NodeAllocatorTraits::deallocate(m_nodeAllocator, pNode, 1);
+}
+
+/**
+ * Copy assignment when the allocator propagates: Adopt the allocator of the right-hand side. Must
+ * be called only on an empty list
+ */
+template<class T, class A>
+void List<T, A>::assignAllocator(const List<T, A> &rhs, std::true_type)
+{
+  assert(m_pFirstNode == 0);
+  m_nodeAllocator = rhs.m_nodeAllocator;
+}
+
+/**
+ * Copy assignment when the allocator does not propagate: Keep our own allocator
+ */
+template<class T, class A>
+void List<T, A>::assignAllocator(const List<T, A> &/*rhs*/, std::false_type)
+{}
+
+/**
+ * Move assignment when the allocator propagates: Adopt the allocator and the nodes of the
+ * right-hand side. Must be called only on an empty list
+ */
+template<class T, class A>
+void List<T, A>::moveAssign(List<T, A> &rhs, std::true_type)
+{
+  assert(m_pFirstNode == 0);
+  m_nodeAllocator = std::move(rhs.m_nodeAllocator);
+  m_pFirstNode = rhs.m_pFirstNode;
+  rhs.m_pFirstNode = 0;
+}
+
+/**
+ * Move assignment when the allocator does not propagate: Nodes can only be stolen if our
+ * allocator is able to release them. Otherwise values are moved into nodes of our own. Must be
+ * called only on an empty list
+ */
+template<class T, class A>
+void List<T, A>::moveAssign(List<T, A> &rhs, std::false_type)
+{
+  assert(m_pFirstNode == 0);
+  if (m_nodeAllocator == rhs.m_nodeAllocator) {
+    m_pFirstNode = rhs.m_pFirstNode;
+    rhs.m_pFirstNode = 0;
+  }
+  else {
+    moveFrom(rhs);
+    rhs.release();
+  }
+}
+
 #endif
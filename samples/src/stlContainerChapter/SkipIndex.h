@@ -0,0 +1,250 @@
+/**
+ * Skip index for positional access into a chain of nodes linked through m_pNextNode
+ *   - every stride-th node is recorded in a side vector. Nodes are counted from the end of the
+ *     chain, so that pushing nodes at the front never invalidates the index: The new nodes are
+ *     simply appended to it when their distance from the end is a multiple of the stride
+ *   - any other modification of the chain (splicing, sorting, merging, erasure) invalidates the
+ *     index, which is rebuilt lazily, in one linear pass, by the next positional access
+ *   - positional access then costs O(stride) node steps instead of O(position). With a stride
+ *     around the square root of the size, this is O(sqrt(n)), for about n / stride pointers of
+ *     memory
+ *   - advance() starts from a node whose position is unknown: It walks until it meets an indexed
+ *     node, looked up by binary search in a vector of (node, entry) pairs sorted by address, of
+ *     another two words per indexed node. Nodes pushed at the front are appended to it unsorted,
+ *     and merged in by the next advance()
+ */
+
+#ifndef SKIPINDEX_H
+#define SKIPINDEX_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+template<class Node>
+class SkipIndex {
+public:
+  explicit SkipIndex(std::size_t stride);
+
+  std::size_t stride() const;
+
+  void pushedFront(Node *pFirstNode, std::size_t count = 1);
+  void invalidate();
+
+  Node *nodeAt(Node *pFirstNode, std::size_t position);
+  Node *advance(Node *pFirstNode, Node *pNode, std::size_t n);
+
+private:
+  struct Entry {
+    const Node *m_pNode;
+    std::size_t m_entry;
+  };
+
+  // Not copyable
+  SkipIndex(const SkipIndex &rhs);
+  SkipIndex &operator=(const SkipIndex &rhs);
+
+  void build(Node *pFirstNode);
+  Node *nodeAtDistance(Node *pFirstNode, std::size_t distance) const;
+
+  void sortEntries();
+  const Entry *findEntry(const Node *pNode) const;
+  static bool isBefore(const Entry &lhs, const Entry &rhs);
+
+  std::size_t m_stride;
+
+  bool m_isBuilt;
+  std::size_t m_size;
+
+  // m_nodes[i] is the node i * m_stride positions before the last node
+  std::vector<Node *> m_nodes;
+  // Reverse lookup, from an indexed node to its entry in m_nodes. The first m_sortedEntryCount
+  // entries are sorted by node address, those of the nodes pushed since follow
+  std::vector<Entry> m_entries;
+  std::size_t m_sortedEntryCount;
+};
+
+template<class Node>
+SkipIndex<Node>::SkipIndex(std::size_t stride)
+: m_stride(stride),
+  m_isBuilt(false),
+  m_size(0),
+  m_sortedEntryCount(0)
+{
+  assert(stride > 0);
+}
+
+template<class Node>
+std::size_t SkipIndex<Node>::stride() const
+{
+  return m_stride;
+}
+
+/**
+ * Keep the index up to date after count nodes, starting with pFirstNode, were pushed at the front
+ * of the chain. If memory runs out, the index is invalidated instead
+ */
+template<class Node>
+void SkipIndex<Node>::pushedFront(Node *pFirstNode, std::size_t count)
+{
+  if (! m_isBuilt || count == 0) {
+    return;
+  }
+
+  try {
+    std::size_t size = m_size + count;
+    m_nodes.resize((size - 1) / m_stride + 1);
+    Node *pNode = pFirstNode;
+    for (std::size_t i = 0; i < count; ++i, pNode = pNode->m_pNextNode) {
+      std::size_t distance = size - 1 - i;
+      if (distance % m_stride == 0) {
+        m_nodes[distance / m_stride] = pNode;
+        Entry entry = { pNode, distance / m_stride };
+        m_entries.push_back(entry);
+      }
+    }
+    m_size = size;
+  }
+  catch (...) {
+    invalidate();
+  }
+}
+
+template<class Node>
+void SkipIndex<Node>::invalidate()
+{
+  if (m_isBuilt) {
+    m_isBuilt = false;
+    m_nodes.clear();
+    m_entries.clear();
+    m_sortedEntryCount = 0;
+  }
+}
+
+/**
+ * Return the node at the given position from the front, or null if the chain is shorter
+ */
+template<class Node>
+Node *SkipIndex<Node>::nodeAt(Node *pFirstNode, std::size_t position)
+{
+  if (! m_isBuilt) {
+    build(pFirstNode);
+  }
+
+  if (position >= m_size) {
+    return 0;
+  }
+  return nodeAtDistance(pFirstNode, m_size - 1 - position);
+}
+
+/**
+ * Return the node n positions after pNode, or null if the chain is shorter. Walks at most about
+ * one stride from pNode to find an indexed node, then jumps
+ */
+template<class Node>
+Node *SkipIndex<Node>::advance(Node *pFirstNode, Node *pNode, std::size_t n)
+{
+  if (! m_isBuilt) {
+    build(pFirstNode);
+  }
+  sortEntries();
+
+  for (; n > 0 && pNode; --n) {
+    const Entry *pEntry = findEntry(pNode);
+    if (pEntry) {
+      std::size_t distance = pEntry->m_entry * m_stride;
+      return n > distance ? 0 : nodeAtDistance(pFirstNode, distance - n);
+    }
+    pNode = pNode->m_pNextNode;
+  }
+  return pNode;
+}
+
+template<class Node>
+void SkipIndex<Node>::build(Node *pFirstNode)
+{
+  m_entries.clear();
+  m_sortedEntryCount = 0;
+  m_size = 0;
+  for (Node *pNode = pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    ++m_size;
+  }
+
+  // Walking from the front, the first indexed node is the one whose distance from the end is the
+  // largest multiple of the stride
+  std::size_t entryCount = m_size ? (m_size - 1) / m_stride + 1 : 0;
+  m_nodes.resize(entryCount);
+  m_entries.reserve(entryCount);
+  std::size_t distance = m_size - 1;
+  for (Node *pNode = pFirstNode; pNode; pNode = pNode->m_pNextNode, --distance) {
+    if (distance % m_stride == 0) {
+      m_nodes[distance / m_stride] = pNode;
+      Entry entry = { pNode, distance / m_stride };
+      m_entries.push_back(entry);
+    }
+  }
+  m_isBuilt = true;
+}
+
+/**
+ * Return the node the given distance before the last node, starting from the closest indexed
+ * node at or before it
+ */
+template<class Node>
+Node *SkipIndex<Node>::nodeAtDistance(Node *pFirstNode, std::size_t distance) const
+{
+  std::size_t entry = (distance + m_stride - 1) / m_stride;
+  Node *pNode;
+  std::size_t steps;
+  if (entry < m_nodes.size()) {
+    pNode = m_nodes[entry];
+    steps = entry * m_stride - distance;
+  }
+  else {
+    pNode = pFirstNode;
+    steps = m_size - 1 - distance;
+  }
+
+  for (; steps > 0; --steps) {
+    pNode = pNode->m_pNextNode;
+  }
+  return pNode;
+}
+
+/**
+ * Sort the entries appended since the last call, and merge them with the others. Neither sorting
+ * nor merging throws: Merging falls back to a slower algorithm if it cannot allocate a buffer
+ */
+template<class Node>
+void SkipIndex<Node>::sortEntries()
+{
+  if (m_sortedEntryCount == m_entries.size()) {
+    return;
+  }
+  typename std::vector<Entry>::iterator middle = m_entries.begin() + m_sortedEntryCount;
+  std::sort(middle, m_entries.end(), isBefore);
+  std::inplace_merge(m_entries.begin(), middle, m_entries.end(), isBefore);
+  m_sortedEntryCount = m_entries.size();
+}
+
+/**
+ * Return the entry of pNode, or null if it is not indexed. The entries must be sorted
+ */
+template<class Node>
+const typename SkipIndex<Node>::Entry *SkipIndex<Node>::findEntry(const Node *pNode) const
+{
+  Entry key = { pNode, 0 };
+  typename std::vector<Entry>::const_iterator entry
+    = std::lower_bound(m_entries.begin(), m_entries.end(), key, isBefore);
+  return entry != m_entries.end() && entry->m_pNode == pNode ? &*entry : 0;
+}
+
+template<class Node>
+bool SkipIndex<Node>::isBefore(const Entry &lhs, const Entry &rhs)
+{
+  return std::less<const Node *>()(lhs.m_pNode, rhs.m_pNode);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "StringPool.h"
+
+#include <functional>
+
+StringPool::StringPool()
+{}
+
+/**
+ * Return the pooled copy of value, adding it to the pool if it is not there yet
+ */
+const std::string *StringPool::intern(const std::string &value)
+{
+  Shard &shard = shardFor(value);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  return &*shard.m_values.insert(value).first;
+}
+
+/**
+ * Return the pooled copy of value, or null if it was never interned. Never adds to the pool, so
+ * that looking up unknown values does not grow it
+ */
+const std::string *StringPool::find(const std::string &value) const
+{
+  const Shard &shard = shardFor(value);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  std::unordered_set<std::string>::const_iterator it = shard.m_values.find(value);
+  return it != shard.m_values.end() ? &*it : 0;
+}
+
+/**
+ * Number of distinct values. Values interned concurrently may or may not be counted
+ */
+std::size_t StringPool::size() const
+{
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < s_shardCount; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+    size += m_shards[i].m_values.size();
+  }
+  return size;
+}
+
+/**
+ * Pool shared by the lists which are not given one. Created on first use, in a thread-safe way
+ */
+StringPool &StringPool::global()
+{
+  static StringPool pool;
+  return pool;
+}
+
+/**
+ * The shard is chosen from the high bits of the hash, since the sets use the low ones
+ */
+const StringPool::Shard &StringPool::shardFor(const std::string &value) const
+{
+  std::size_t hash = std::hash<std::string>()(value);
+  return m_shards[hash >> (sizeof(std::size_t) * 8 - s_shardBits)];
+}
+
+StringPool::Shard &StringPool::shardFor(const std::string &value)
+{
+  return const_cast<Shard &>(static_cast<const StringPool *>(this)->shardFor(value));
+}
@@ -0,0 +1,53 @@
+/**
+ * Pool of interned strings
+ *   - each distinct value is stored once. intern() returns a pointer to the pooled copy, which
+ *     stays valid as long as the pool exists: Two values interned in the same pool are equal if
+ *     and only if their pointers are
+ *   - monotonic: values are never removed, so that handles never dangle. The pool is meant for
+ *     values drawn from a limited vocabulary (names, keys, tags), not for arbitrary data
+ *   - thread-safe: the values are spread over shards by hash, each protected by its own mutex, so
+ *     that threads interning different values rarely contend. Pooled values are immutable and may
+ *     be read without locking
+ */
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+class StringPool {
+public:
+  StringPool();
+
+  const std::string *intern(const std::string &value);
+  const std::string *find(const std::string &value) const;
+
+  std::size_t size() const;
+
+  static StringPool &global();
+
+private:
+  // Padded to a cache line, so that threads locking neighbouring shards do not share one
+  struct alignas(64) Shard {
+    mutable std::mutex m_mutex;
+    // Elements of an unordered_set never move, even when it rehashes
+    std::unordered_set<std::string> m_values;
+  };
+
+  // Not copyable: Handles point into the pool
+  StringPool(const StringPool &rhs);
+  StringPool &operator=(const StringPool &rhs);
+
+  const Shard &shardFor(const std::string &value) const;
+  Shard &shardFor(const std::string &value);
+
+  static const unsigned s_shardBits = 4;
+  static const std::size_t s_shardCount = std::size_t(1) << s_shardBits;
+
+  Shard m_shards[s_shardCount];
+};
+
+#endif
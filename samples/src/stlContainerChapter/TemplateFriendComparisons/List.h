@@ -2,15 +2,47 @@
  * Implementation of a list container
  *   - does not conform to the STL conventions
  *   - friend iterator comparison operators
+ *   - statistics policy S (see ListStats.h), from which the list inherits privately. The default
+ *     DefaultListStats is CountingListStats if LIST_STATS is defined to 1, and NoListStats
+ *     otherwise, which takes no room and whose hooks compile to nothing
+ *   - searches (find, count, contains, min, max) are plain loops over the nodes: With a single
+ *     value per node, there is no block of values to compare at once
+ *   - nodes removed by pop_front and erase_after are recycled: Their storage is kept by the list
+ *     and reused by the next nodes it creates, so that pushing and popping never hit the heap once
+ *     the list has reached its usual length. The recycled storage is freed with the list (or when
+ *     it is assigned to)
+ *   - compact() moves the nodes of an arena list whose nodes got scattered into contiguous
+ *     storage, in list order, so that traversals walk memory sequentially again. meanNodeStride()
+ *     tells how scattered the nodes are. Heap nodes are freed one by one, so heap lists are not
+ *     compacted
+ *   - the arena and the skip index, which most lists do not use, live in an extension allocated
+ *     by the first of them, so that a plain list takes three pointers
+ *   - under C++20, heap lists with the NoListStats policy can be built, copied, sorted, merged,
+ *     searched and destroyed in constant evaluation: These members are declared LIST_CONSTEXPR
+ *     (see ListConstexpr.h). Removing elements recycles nodes with placement new, which constant
+ *     evaluation does not allow
  */
 
 #ifndef LIST_H
 #define LIST_H
 
+#include "ListConstexpr.h"
+#include "ListStats.h"
+#include "MonotonicArena.h"
+#include "Prefetch.h"
+#include "SkipIndex.h"
+
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template<class T>
-class List {
+template<class T, class S = DefaultListStats>
+class List : private S {
 private:
   struct Node;
 
@@ -19,20 +51,20 @@ public:
 
   class ConstIterator {
   public:
-    ConstIterator();
-    ConstIterator(const Iterator &rhs);
+    LIST_CONSTEXPR ConstIterator();
+    LIST_CONSTEXPR ConstIterator(const Iterator &rhs);
 
-    ConstIterator &operator++();
-    const ConstIterator operator++(int);
+    LIST_CONSTEXPR ConstIterator &operator++();
+    LIST_CONSTEXPR const ConstIterator operator++(int);
 
-    const T *operator->() const;
-    const T &operator*() const;
+    LIST_CONSTEXPR const T *operator->() const;
+    LIST_CONSTEXPR const T &operator*() const;
 
-    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    LIST_CONSTEXPR friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
     {
       return lhs.m_pNode == rhs.m_pNode;
     }
-    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    LIST_CONSTEXPR friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
     {
       return lhs.m_pNode != rhs.m_pNode;
     }
@@ -40,26 +72,26 @@ public:
   private:
     friend class List;
 
-    explicit ConstIterator(const Node *);
+    LIST_CONSTEXPR explicit ConstIterator(const Node *);
 
     const Node *m_pNode;
   };
 
   class Iterator {
   public:
-    Iterator();
+    LIST_CONSTEXPR Iterator();
 
-    Iterator &operator++();
-    const Iterator operator++(int);
+    LIST_CONSTEXPR Iterator &operator++();
+    LIST_CONSTEXPR const Iterator operator++(int);
 
-    T *operator->() const;
-    T &operator*() const;
+    LIST_CONSTEXPR T *operator->() const;
+    LIST_CONSTEXPR T &operator*() const;
 
-    friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+    LIST_CONSTEXPR friend bool operator==(const Iterator &lhs, const Iterator &rhs)
     {
       return lhs.m_pNode == rhs.m_pNode;
     }
-    friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+    LIST_CONSTEXPR friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
     {
       return lhs.m_pNode != rhs.m_pNode;
     }
@@ -68,140 +100,263 @@ public:
     friend class List;
     friend class ConstIterator;
 
-    explicit Iterator(Node *pNode);
+    LIST_CONSTEXPR explicit Iterator(Node *pNode);
 
     Node *m_pNode;
   };
 
-  List();
+  LIST_CONSTEXPR List();
+  explicit List(MonotonicArena &arena);
   
-  List(const List &rhs);
-  List &operator=(const List &rhs);
+  LIST_CONSTEXPR List(const List &rhs);
+  LIST_CONSTEXPR List &operator=(const List &rhs);
+
+  LIST_CONSTEXPR ~List();
+
+  LIST_CONSTEXPR ConstIterator begin() const;
+  LIST_CONSTEXPR Iterator begin();
+
+  LIST_CONSTEXPR ConstIterator end() const;
+  LIST_CONSTEXPR Iterator end();
+
+  LIST_CONSTEXPR void push_front(const T &value);
+  template<class InputIterator>
+  LIST_CONSTEXPR void push_front(InputIterator first, InputIterator last);
+  void pop_front();
+
+  Iterator insert_after(ConstIterator position, const T &value);
+  Iterator erase_after(ConstIterator position);
+  Iterator erase_after(ConstIterator position, ConstIterator last);
+
+  void splice_front(List &other);
+  void splice_after(ConstIterator position, List &other);
+  void splice_after(ConstIterator position, List &other, ConstIterator first, ConstIterator last);
+
+  LIST_CONSTEXPR void sort();
+  template<class Compare>
+  LIST_CONSTEXPR void sort(Compare compare);
+
+  LIST_CONSTEXPR void merge(List &other);
+  template<class Compare>
+  LIST_CONSTEXPR void merge(List &other, Compare compare);
+
+  void setSkipIndexStride(std::size_t stride);
 
-  ~List();
+  const T &at(std::size_t position) const;
+  T &at(std::size_t position);
 
-  ConstIterator begin() const;
-  Iterator begin();
+  ConstIterator advance(ConstIterator it, std::size_t n) const;
+  Iterator advance(Iterator it, std::size_t n);
 
-  ConstIterator end() const;
-  Iterator end();
+  LIST_CONSTEXPR ConstIterator find(const T &value) const;
+  LIST_CONSTEXPR Iterator find(const T &value);
+  LIST_CONSTEXPR std::size_t count(const T &value) const;
+  LIST_CONSTEXPR bool contains(const T &value) const;
 
-  void push_front(const T &value);
+  LIST_CONSTEXPR ConstIterator min() const;
+  LIST_CONSTEXPR ConstIterator max() const;
+
+  void compact();
+  double meanNodeStride() const;
 
 private:
-  void createFrom(const List &rhs);
-  void release();
+  // Storage of an erased node, linked through its own storage until it is reused
+  struct RecycledNode {
+    RecycledNode *m_pNextRecycledNode;
+  };
+
+  // State of the features which most lists do not use
+  struct Extension {
+    Extension();
+    Extension(const Extension &rhs);
+    ~Extension();
+
+    bool isUsed() const;
+
+    MonotonicArena *m_pArena;
+    SkipIndex<Node> *m_pSkipIndex;
+
+  private:
+    Extension &operator=(const Extension &);
+  };
+
+  template<class Compare>
+  LIST_CONSTEXPR static Node *mergeChains(Node *pLeftNode, Node *pRightNode, Compare compare);
+
+  LIST_CONSTEXPR Node *createNode(const T &value, Node *pNextNode);
+  LIST_CONSTEXPR void destroyNode(Node *pNode);
+  void recycleNode(Node *pNode);
+  LIST_CONSTEXPR void releaseRecycledNodes();
+
+  LIST_CONSTEXPR void createFrom(const List &rhs);
+  LIST_CONSTEXPR void release();
+
+  Node *nodeAt(std::size_t position) const;
+  Node *advanceNode(Node *pNode, std::size_t n) const;
+  LIST_CONSTEXPR void invalidateSkipIndex();
+
+  // Null if nodes are allocated on the global heap, or if positional access is not indexed
+  LIST_CONSTEXPR MonotonicArena *arena() const;
+  LIST_CONSTEXPR SkipIndex<Node> *skipIndex() const;
+
+  Extension &extension();
+  void releaseUnusedExtension();
 
   Node *m_pFirstNode;
+
+  // Storage of erased nodes, to be reused
+  RecycledNode *m_pFirstRecycledNode;
+
+  // Null until a list uses an arena or a skip index
+  Extension *m_pExtension;
 };
 
-template<class T>
-struct List<T>::Node {
-  Node(const T &value, Node *pNextNode);
+template<class T, class S>
+struct List<T, S>::Node {
+  LIST_CONSTEXPR Node(const T &value, Node *pNextNode);
+  LIST_CONSTEXPR Node(T &&value, Node *pNextNode);
 
   T m_value;
   Node *m_pNextNode;
 };
 
-template<class T>
-List<T>::Node::Node(const T &value, Node *pNextNode)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::Node::Node(const T &value, Node *pNextNode)
 : m_value(value),
   m_pNextNode(pNextNode)
 {}
 
-template<class T>
-List<T>::ConstIterator::ConstIterator()
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::Node::Node(T &&value, Node *pNextNode)
+: m_value(std::move(value)),
+  m_pNextNode(pNextNode)
+{}
+
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::ConstIterator::ConstIterator()
 : m_pNode(0)
 {}
 
-template<class T>
-List<T>::ConstIterator::ConstIterator(const Iterator &rhs)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::ConstIterator::ConstIterator(const Iterator &rhs)
 : m_pNode(rhs.m_pNode)
 {}
 
-template<class T>
-typename List<T>::ConstIterator &List<T>::ConstIterator::operator++()
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator &List<T, S>::ConstIterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
+  S::traversalStep();
   return *this;
 }
 
-template<class T>
-const typename List<T>::ConstIterator List<T>::ConstIterator::operator++(int)
+template<class T, class S>
+LIST_CONSTEXPR const typename List<T, S>::ConstIterator List<T, S>::ConstIterator::operator++(int)
 {
   ConstIterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
+  S::traversalStep();
   return tmp;
 }
 
-template<class T>
-const T *List<T>::ConstIterator::operator->() const
+template<class T, class S>
+LIST_CONSTEXPR const T *List<T, S>::ConstIterator::operator->() const
 {
   return &m_pNode->m_value;
 }
 
-template<class T>
-const T &List<T>::ConstIterator::operator*() const
+template<class T, class S>
+LIST_CONSTEXPR const T &List<T, S>::ConstIterator::operator*() const
 {
   return m_pNode->m_value;
 }
 
-template<class T>
-List<T>::ConstIterator::ConstIterator(const Node *pNode)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::ConstIterator::ConstIterator(const Node *pNode)
 : m_pNode(pNode)
 {}
 
-template<class T>
-List<T>::Iterator::Iterator()
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::Iterator::Iterator()
 : m_pNode(0)
 {}
 
-template<class T>
-typename List<T>::Iterator &List<T>::Iterator::operator++()
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::Iterator &List<T, S>::Iterator::operator++()
 {
   m_pNode = m_pNode->m_pNextNode;
+  S::traversalStep();
   return *this;
 }
 
-template<class T>
-const typename List<T>::Iterator List<T>::Iterator::operator++(int)
+template<class T, class S>
+LIST_CONSTEXPR const typename List<T, S>::Iterator List<T, S>::Iterator::operator++(int)
 {
   Iterator tmp(*this);
   m_pNode = m_pNode->m_pNextNode;
+  S::traversalStep();
   return tmp;
 }
 
-template<class T>
-T *List<T>::Iterator::operator->() const
+template<class T, class S>
+LIST_CONSTEXPR T *List<T, S>::Iterator::operator->() const
 {
   return &m_pNode->m_value;
 }
 
-template<class T>
-T &List<T>::Iterator::operator*() const
+template<class T, class S>
+LIST_CONSTEXPR T &List<T, S>::Iterator::operator*() const
 {
   return m_pNode->m_value;
 }
 
-template<class T>
-List<T>::Iterator::Iterator(Node *pNode)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::Iterator::Iterator(Node *pNode)
 : m_pNode(pNode)
 {}
 
-template<class T>
-List<T>::List()
-: m_pFirstNode(0)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::List()
+: m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(0)
 {}
 
-template<class T>
-List<T>::List(const List<T> &rhs)
-: m_pFirstNode(0)
+/**
+ * Create an empty list whose nodes are allocated in the given arena, which must outlive the list.
+ * Destroying the list only destroys the values; the node storage is reclaimed when the arena is
+ * reset
+ */
+template<class T, class S>
+List<T, S>::List(MonotonicArena &arena)
+: m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(new Extension)
+{
+  m_pExtension->m_pArena = &arena;
+}
+
+/**
+ * The copy shares the arena of the original list, and gets a skip index of its own
+ */
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::List(const List<T, S> &rhs)
+: S(),
+  m_pFirstNode(0),
+  m_pFirstRecycledNode(0),
+  m_pExtension(rhs.m_pExtension ? new Extension(*rhs.m_pExtension) : 0)
 {
-  createFrom(rhs);
+  try {
+    createFrom(rhs);
+  }
+  catch (...) {
+    delete m_pExtension;
+    throw;
+  }
 }
 
-template<class T>
-List<T> &List<T>::operator=(const List<T> &rhs)
+template<class T, class S>
+LIST_CONSTEXPR List<T, S> &List<T, S>::operator=(const List<T, S> &rhs)
 {
   // Check for self-assignment
   if (this != &rhs) {
@@ -211,83 +366,800 @@ List<T> &List<T>::operator=(const List<T> &rhs)
   return *this;
 }
 
-template<class T>
-List<T>::~List()
+template<class T, class S>
+LIST_CONSTEXPR List<T, S>::~List()
 {
   release();
+  delete m_pExtension;
 }
 
-template<class T>
-typename List<T>::ConstIterator List<T>::begin() const
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator List<T, S>::begin() const
 {
+  S::traversalStarted();
   return ConstIterator(m_pFirstNode);
 }
 
-template<class T>
-typename List<T>::Iterator List<T>::begin()
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::Iterator List<T, S>::begin()
 {
+  S::traversalStarted();
   return Iterator(m_pFirstNode);
 }
 
-template<class T>
-typename List<T>::ConstIterator List<T>::end() const
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator List<T, S>::end() const
 {
   return ConstIterator(0);
 }
 
-template<class T>
-typename List<T>::Iterator List<T>::end()
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::Iterator List<T, S>::end()
 {
   return Iterator(0);
 }
 
-template<class T>
-void List<T>::push_front(const T &value)
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::push_front(const T &value)
 {
-  Node *pNode = new Node(value, m_pFirstNode);
+  Node *pNode = createNode(value, m_pFirstNode);
   m_pFirstNode = pNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(pNode);
+  }
+}
+
+/**
+ * Insert copies of the values in [first, last) at the front of the list, in the same order. The
+ * new nodes are chained locally and published with a single update of the first node, so that
+ * the list is left unchanged if a copy throws
+ */
+template<class T, class S>
+template<class InputIterator>
+LIST_CONSTEXPR void List<T, S>::push_front(InputIterator first, InputIterator last)
+{
+  Node *pFirstNode = 0;
+  Node **ppNextNode = &pFirstNode;
+  std::size_t count = 0;
+  try {
+    for (; first != last; ++first, ++count) {
+      *ppNextNode = createNode(*first, 0);
+      ppNextNode = &(*ppNextNode)->m_pNextNode;
+    }
+  }
+  catch (...) {
+    while (pFirstNode) {
+      Node *pNextNode = pFirstNode->m_pNextNode;
+      destroyNode(pFirstNode);
+      this->nodeDestroyed();
+      pFirstNode = pNextNode;
+    }
+    throw;
+  }
+  *ppNextNode = m_pFirstNode;
+  m_pFirstNode = pFirstNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(pFirstNode, count);
+  }
+}
+
+/**
+ * Remove the first element. The list must not be empty
+ */
+template<class T, class S>
+void List<T, S>::pop_front()
+{
+  assert(m_pFirstNode != 0);
+
+  Node *pNode = m_pFirstNode;
+  m_pFirstNode = pNode->m_pNextNode;
+  recycleNode(pNode);
+  this->nodeDestroyed();
+  invalidateSkipIndex();
+}
+
+/**
+ * Insert a copy of value after position, which must not be end(), and return an iterator to it
+ */
+template<class T, class S>
+typename List<T, S>::Iterator List<T, S>::insert_after(ConstIterator position, const T &value)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pNode = createNode(value, pPositionNode->m_pNextNode);
+  pPositionNode->m_pNextNode = pNode;
+  invalidateSkipIndex();
+  return Iterator(pNode);
+}
+
+/**
+ * Remove the element after position, which must exist, and return an iterator to the element
+ * which followed it
+ */
+template<class T, class S>
+typename List<T, S>::Iterator List<T, S>::erase_after(ConstIterator position)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pNode = pPositionNode->m_pNextNode;
+  assert(pNode != 0);
+
+  pPositionNode->m_pNextNode = pNode->m_pNextNode;
+  recycleNode(pNode);
+  this->nodeDestroyed();
+  invalidateSkipIndex();
+  return Iterator(pPositionNode->m_pNextNode);
+}
+
+/**
+ * Remove the elements strictly between position and last. Constant time per element
+ */
+template<class T, class S>
+typename List<T, S>::Iterator List<T, S>::erase_after(ConstIterator position, ConstIterator last)
+{
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pEndNode = const_cast<Node *>(last.m_pNode);
+  while (pPositionNode->m_pNextNode != pEndNode) {
+    Node *pNode = pPositionNode->m_pNextNode;
+    pPositionNode->m_pNextNode = pNode->m_pNextNode;
+    recycleNode(pNode);
+    this->nodeDestroyed();
+  }
+  invalidateSkipIndex();
+  return Iterator(pEndNode);
+}
+
+/**
+ * Move all elements of other to the front of the list, in the same order. Nothing is allocated
+ * or copied, but other has to be walked to find its last node
+ */
+template<class T, class S>
+void List<T, S>::splice_front(List<T, S> &other)
+{
+  if (&other == this || ! other.m_pFirstNode) {
+    return;
+  }
+  assert(arena() == other.arena());
+
+  Node *pLastNode = other.m_pFirstNode;
+  std::size_t count = 1;
+  for (; pLastNode->m_pNextNode; ++count) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  pLastNode->m_pNextNode = m_pFirstNode;
+  m_pFirstNode = other.m_pFirstNode;
+  other.m_pFirstNode = 0;
+  this->nodesMoved(other, count);
+
+  // The nodes were added at the front, so the skip index of the list remains valid
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->pushedFront(m_pFirstNode, count);
+  }
+  other.invalidateSkipIndex();
+}
+
+/**
+ * Move all elements of other after position, in the same order. Nothing is allocated or copied,
+ * but other has to be walked to find its last node
+ */
+template<class T, class S>
+void List<T, S>::splice_after(ConstIterator position, List<T, S> &other)
+{
+  assert(&other != this);
+  assert(arena() == other.arena());
+
+  if (! other.m_pFirstNode) {
+    return;
+  }
+
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pLastNode = other.m_pFirstNode;
+  while (pLastNode->m_pNextNode) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  pLastNode->m_pNextNode = pPositionNode->m_pNextNode;
+  pPositionNode->m_pNextNode = other.m_pFirstNode;
+  other.m_pFirstNode = 0;
+  this->allNodesMoved(other);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+}
+
+/**
+ * Move the elements of other strictly between first and last after position (other may be the
+ * list itself, provided position is not within the range). The cost is linear in the length of
+ * the range, and constant when a single element is moved
+ */
+template<class T, class S>
+void List<T, S>::splice_after(ConstIterator position, List<T, S> &other, ConstIterator first,
+  ConstIterator last)
+{
+  assert(arena() == other.arena());
+
+  Node *pPositionNode = const_cast<Node *>(position.m_pNode);
+  Node *pBeforeFirstNode = const_cast<Node *>(first.m_pNode);
+  Node *pEndNode = const_cast<Node *>(last.m_pNode);
+
+  // Nothing to move, or the range already follows position
+  if (pBeforeFirstNode->m_pNextNode == pEndNode || pPositionNode == pBeforeFirstNode) {
+    return;
+  }
+
+  Node *pFirstNode = pBeforeFirstNode->m_pNextNode;
+  Node *pLastNode = pFirstNode;
+  std::size_t count = 1;
+  for (; pLastNode->m_pNextNode != pEndNode; ++count) {
+    pLastNode = pLastNode->m_pNextNode;
+  }
+  pBeforeFirstNode->m_pNextNode = pEndNode;
+  pLastNode->m_pNextNode = pPositionNode->m_pNextNode;
+  pPositionNode->m_pNextNode = pFirstNode;
+  this->nodesMoved(other, count);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+}
+
+/**
+ * Stable sort, in ascending order according to operator<
+ */
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::sort()
+{
+  sort(std::less<T>());
+}
+
+/**
+ * Stable bottom-up merge sort. Only the links between nodes are changed: Nothing is allocated,
+ * copied or moved, and iterators remain valid. Runs of 2^i nodes are kept in bins, and merged
+ * together like the digits of a binary counter are carried
+ */
+template<class T, class S>
+template<class Compare>
+LIST_CONSTEXPR void List<T, S>::sort(Compare compare)
+{
+  // Enough bins for any list which fits in memory
+  const std::size_t binCount = 64;
+  Node *bins[binCount] = {};
+  std::size_t usedBinCount = 0;
+
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pRunNode = pNode;
+    pNode = pNode->m_pNextNode;
+    pRunNode->m_pNextNode = 0;
+
+    // Bins contain nodes which come before the run, so they are merged on the left for stability
+    std::size_t i = 0;
+    for (; i < usedBinCount && bins[i]; ++i) {
+      pRunNode = mergeChains(bins[i], pRunNode, compare);
+      bins[i] = 0;
+    }
+    if (i == binCount) {
+      --i;
+    }
+    bins[i] = pRunNode;
+    if (i == usedBinCount) {
+      ++usedBinCount;
+    }
+  }
+
+  Node *pFirstNode = 0;
+  for (std::size_t i = 0; i < usedBinCount; ++i) {
+    pFirstNode = mergeChains(bins[i], pFirstNode, compare);
+  }
+  m_pFirstNode = pFirstNode;
+  invalidateSkipIndex();
+}
+
+/**
+ * Merge other, which must be sorted as the list, into the list. other is left empty
+ */
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::merge(List<T, S> &other)
+{
+  merge(other, std::less<T>());
+}
+
+/**
+ * Merge other, which must be sorted as the list according to compare, into the list. Equivalent
+ * elements of the list come first. Nodes are relinked, nothing is allocated or copied. other is
+ * left empty
+ */
+template<class T, class S>
+template<class Compare>
+LIST_CONSTEXPR void List<T, S>::merge(List<T, S> &other, Compare compare)
+{
+  if (&other == this) {
+    return;
+  }
+  assert(arena() == other.arena());
+
+  m_pFirstNode = mergeChains(m_pFirstNode, other.m_pFirstNode, compare);
+  other.m_pFirstNode = 0;
+  this->allNodesMoved(other);
+  invalidateSkipIndex();
+  other.invalidateSkipIndex();
+}
+
+/**
+ * Index positional access with one entry every stride elements, or stop indexing it if stride is
+ * 0. The index is built by the first positional access, and kept up to date by push_front()
+ */
+template<class T, class S>
+void List<T, S>::setSkipIndexStride(std::size_t stride)
+{
+  if (! stride) {
+    if (m_pExtension) {
+      delete m_pExtension->m_pSkipIndex;
+      m_pExtension->m_pSkipIndex = 0;
+      releaseUnusedExtension();
+    }
+    return;
+  }
+
+  SkipIndex<Node> *pSkipIndex = new SkipIndex<Node>(stride);
+  try {
+    extension();
+  }
+  catch (...) {
+    delete pSkipIndex;
+    throw;
+  }
+  delete m_pExtension->m_pSkipIndex;
+  m_pExtension->m_pSkipIndex = pSkipIndex;
+}
+
+/**
+ * Return the element at the given position. Throws std::out_of_range if the list is shorter.
+ * Linear in position, or in the stride if the list is indexed
+ */
+template<class T, class S>
+const T &List<T, S>::at(std::size_t position) const
+{
+  return nodeAt(position)->m_value;
+}
+
+template<class T, class S>
+T &List<T, S>::at(std::size_t position)
+{
+  return nodeAt(position)->m_value;
+}
+
+/**
+ * Return an iterator n elements after it, or end() if the list is shorter. Linear in n, or
+ * in the stride if the list is indexed
+ */
+template<class T, class S>
+typename List<T, S>::ConstIterator List<T, S>::advance(ConstIterator it, std::size_t n) const
+{
+  return ConstIterator(advanceNode(const_cast<Node *>(it.m_pNode), n));
+}
+
+template<class T, class S>
+typename List<T, S>::Iterator List<T, S>::advance(Iterator it, std::size_t n)
+{
+  return Iterator(advanceNode(it.m_pNode, n));
+}
+
+/**
+ * Return an iterator to the first element equal to value, or end() if there is none
+ */
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator List<T, S>::find(const T &value) const
+{
+  const Node *pNode = m_pFirstNode;
+  while (pNode && ! (pNode->m_value == value)) {
+    pNode = pNode->m_pNextNode;
+  }
+  return ConstIterator(pNode);
+}
+
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::Iterator List<T, S>::find(const T &value)
+{
+  return Iterator(const_cast<Node *>(static_cast<const List<T, S> &>(*this).find(value).m_pNode));
+}
+
+/**
+ * Return the number of elements equal to value
+ */
+template<class T, class S>
+LIST_CONSTEXPR std::size_t List<T, S>::count(const T &value) const
+{
+  std::size_t equalCount = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    if (pNode->m_value == value) {
+      ++equalCount;
+    }
+  }
+  return equalCount;
+}
+
+template<class T, class S>
+LIST_CONSTEXPR bool List<T, S>::contains(const T &value) const
+{
+  return find(value) != end();
+}
+
+/**
+ * Return an iterator to the first smallest element, or end() if the list is empty
+ */
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator List<T, S>::min() const
+{
+  const Node *pMinNode = m_pFirstNode;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    if (pNode->m_value < pMinNode->m_value) {
+      pMinNode = pNode;
+    }
+  }
+  return ConstIterator(pMinNode);
+}
+
+/**
+ * Return an iterator to the first largest element, or end() if the list is empty
+ */
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::ConstIterator List<T, S>::max() const
+{
+  const Node *pMaxNode = m_pFirstNode;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    if (pMaxNode->m_value < pNode->m_value) {
+      pMaxNode = pNode;
+    }
+  }
+  return ConstIterator(pMaxNode);
+}
+
+/**
+ * Merge two sorted chains of nodes and return the first node of the result. Stable: when
+ * elements are equivalent, those of the left chain come first
+ */
+template<class T, class S>
+template<class Compare>
+LIST_CONSTEXPR typename List<T, S>::Node *List<T, S>::mergeChains(Node *pLeftNode, Node *pRightNode,
+  Compare compare)
+{
+  Node *pFirstNode = 0;
+  Node **ppNextNode = &pFirstNode;
+  while (pLeftNode && pRightNode) {
+    if (compare(pRightNode->m_value, pLeftNode->m_value)) {
+      *ppNextNode = pRightNode;
+      pRightNode = pRightNode->m_pNextNode;
+    }
+    else {
+      *ppNextNode = pLeftNode;
+      pLeftNode = pLeftNode->m_pNextNode;
+    }
+    ppNextNode = &(*ppNextNode)->m_pNextNode;
+  }
+  *ppNextNode = pLeftNode ? pLeftNode : pRightNode;
+  return pFirstNode;
+}
+
+/**
+ * Create a node, drawing its storage from the recycled nodes, or else from the arena if the list
+ * has one
+ */
+template<class T, class S>
+LIST_CONSTEXPR typename List<T, S>::Node *List<T, S>::createNode(const T &value, Node *pNextNode)
+{
+  MonotonicArena *pArena = arena();
+  Node *pNode;
+  if (m_pFirstRecycledNode) {
+    RecycledNode *pRecycledNode = m_pFirstRecycledNode;
+    m_pFirstRecycledNode = pRecycledNode->m_pNextRecycledNode;
+    try {
+      pNode = new (static_cast<void *>(pRecycledNode)) Node(value, pNextNode);
+    }
+    catch (...) {
+      // The value constructor may have overwritten the link: It is written again
+      pRecycledNode = new (static_cast<void *>(pRecycledNode)) RecycledNode;
+      pRecycledNode->m_pNextRecycledNode = m_pFirstRecycledNode;
+      m_pFirstRecycledNode = pRecycledNode;
+      throw;
+    }
+  }
+  else if (! pArena) {
+    pNode = new Node(value, pNextNode);
+  }
+  else {
+    // If the value constructor throws, the storage is simply lost until the arena is reset
+    pNode = new (pArena->allocate(sizeof(Node), alignof(Node))) Node(value, pNextNode);
+  }
+  this->nodeCreated();
+  return pNode;
+}
+
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::destroyNode(Node *pNode)
+{
+  if (! arena()) {
+    delete pNode;
+  }
+  else {
+    pNode->~Node();
+  }
+}
+
+/**
+ * Destroy a node removed from the list, and keep its storage for the next node created
+ */
+template<class T, class S>
+void List<T, S>::recycleNode(Node *pNode)
+{
+  pNode->~Node();
+  RecycledNode *pRecycledNode = new (static_cast<void *>(pNode)) RecycledNode;
+  pRecycledNode->m_pNextRecycledNode = m_pFirstRecycledNode;
+  m_pFirstRecycledNode = pRecycledNode;
+}
+
+/**
+ * Free the storage of recycled nodes. Arena storage is only reclaimed when the arena is reset
+ */
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::releaseRecycledNodes()
+{
+  if (! arena()) {
+    while (m_pFirstRecycledNode) {
+      RecycledNode *pNextRecycledNode = m_pFirstRecycledNode->m_pNextRecycledNode;
+      // Over-aligned nodes were allocated by the aligned operator new
+      if (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(m_pFirstRecycledNode, std::align_val_t(alignof(Node)));
+      }
+      else {
+        ::operator delete(m_pFirstRecycledNode);
+      }
+      m_pFirstRecycledNode = pNextRecycledNode;
+    }
+  }
+  m_pFirstRecycledNode = 0;
 }
 
 /**
  * Function factoring out the code for creating a list from an existing one. Must
- * be called only on an empty list
+ * be called only on an empty list. The nodes of rhs are walked directly rather than through
+ * push_front(first, last), so that they can be prefetched
  */
-template<class T>
-void List<T>::createFrom(const List<T> &rhs)
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::createFrom(const List<T, S> &rhs)
 {
   // Ensure that the list is empty
   assert(m_pFirstNode == 0);
 
-  Node *pRhsNode = rhs.m_pFirstNode;
-  Node *pNode = 0;
-  while (pRhsNode) {
-    // Empty list; create first node
-    if (! m_pFirstNode) {
-      m_pFirstNode = new Node(pRhsNode->m_value, 0);
-      pNode = m_pFirstNode;
+  typename S::Stopwatch stopwatch;
+  Node **ppNextNode = &m_pFirstNode;
+  const Node *pRhsNode = rhs.m_pFirstNode;
+  const Node *pAheadRhsNode = prefetchNodesAhead(pRhsNode);
+  try {
+    while (pRhsNode) {
+      pAheadRhsNode = prefetchNextNode(pAheadRhsNode);
+      *ppNextNode = createNode(pRhsNode->m_value, 0);
+      ppNextNode = &(*ppNextNode)->m_pNextNode;
+      pRhsNode = pRhsNode->m_pNextNode;
     }
-    // Add following nodes
-    else {
-      pNode->m_pNextNode = new Node(pRhsNode->m_value, 0);
-      pNode = pNode->m_pNextNode;
-    }
-    pRhsNode = pRhsNode->m_pNextNode;
   }
+  catch (...) {
+    release();
+    throw;
+  }
+  S::copied(stopwatch);
 }
 
 /**
  * Function factoring out the cleanup code
  */
-template<class T>
-void List<T>::release()
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::release()
 {
+  typename S::Stopwatch stopwatch;
+
+  // Arena nodes of trivially destructible values need no cleanup at all: The list is simply
+  // forgotten, in constant time
+  if (arena() && std::is_trivially_destructible<T>::value) {
+    m_pFirstNode = 0;
+    releaseRecycledNodes();
+    invalidateSkipIndex();
+    this->allNodesDestroyed();
+    S::released(stopwatch);
+    return;
+  }
+
   Node *pNode = m_pFirstNode;
+  Node *pAheadNode = prefetchNodesAhead(pNode);
   while (pNode) {
+    pAheadNode = prefetchNextNode(pAheadNode);
     Node *pNextNode = pNode->m_pNextNode;
-    delete pNode;
+    destroyNode(pNode);
     pNode = pNextNode;
   }
   m_pFirstNode = 0;
+  releaseRecycledNodes();
+  invalidateSkipIndex();
+  this->allNodesDestroyed();
+  S::released(stopwatch);
+}
+
+/**
+ * Move the nodes of an arena list into a single block of its arena, in list order, so that
+ * traversals walk memory sequentially. The values are moved (or copied, if their move
+ * constructor may throw). Iterators, pointers and references to the elements are invalidated.
+ * Linear in the length of the list. The storage of the former nodes is lost until the arena is
+ * reset, and so is recycled storage. A heap list only frees its recycled storage: Its nodes must
+ * remain freeable one by one, and heap nodes allocated one after the other are not laid out in
+ * order once the heap has free storage of their size. If memory runs out or a copy throws, the
+ * list is left unchanged
+ */
+template<class T, class S>
+void List<T, S>::compact()
+{
+  MonotonicArena *pArena = arena();
+  if (! pArena) {
+    releaseRecycledNodes();
+    return;
+  }
+
+  std::size_t count = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    ++count;
+  }
+
+  Node *pCompactedNodes = 0;
+  if (count > 0) {
+    pCompactedNodes = static_cast<Node *>(pArena->allocate(count * sizeof(Node), alignof(Node)));
+  }
+  std::size_t i = 0;
+  try {
+    for (Node *pNode = m_pFirstNode; pNode; ++i, pNode = pNode->m_pNextNode) {
+      new (static_cast<void *>(pCompactedNodes + i))
+        Node(std::move_if_noexcept(pNode->m_value), pCompactedNodes + i + 1);
+    }
+  }
+  catch (...) {
+    // Only copies may throw, so the former nodes are intact. The block is lost until the arena is
+    // reset
+    while (i > 0) {
+      pCompactedNodes[--i].~Node();
+    }
+    throw;
+  }
+  if (count > 0) {
+    pCompactedNodes[count - 1].m_pNextNode = 0;
+  }
+
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pNextNode = pNode->m_pNextNode;
+    pNode->~Node();
+    pNode = pNextNode;
+  }
+  releaseRecycledNodes();
+  m_pFirstNode = pCompactedNodes;
+  invalidateSkipIndex();
+}
+
+/**
+ * Fragmentation metric: The mean distance, in bytes, between the addresses of consecutive nodes.
+ * It is the size of a node once the list is compacted, and grows as its nodes get scattered. 0 for
+ * lists of less than two elements
+ */
+template<class T, class S>
+double List<T, S>::meanNodeStride() const
+{
+  double totalStride = 0;
+  std::size_t strideCount = 0;
+  for (const Node *pNode = m_pFirstNode; pNode && pNode->m_pNextNode; pNode = pNode->m_pNextNode) {
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pNode);
+    std::uintptr_t nextAddress = reinterpret_cast<std::uintptr_t>(pNode->m_pNextNode);
+    totalStride += address < nextAddress ? nextAddress - address : address - nextAddress;
+    ++strideCount;
+  }
+  return strideCount ? totalStride / strideCount : 0;
+}
+
+template<class T, class S>
+typename List<T, S>::Node *List<T, S>::nodeAt(std::size_t position) const
+{
+  Node *pNode;
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pNode = pSkipIndex->nodeAt(m_pFirstNode, position);
+  }
+  else {
+    pNode = advanceNode(m_pFirstNode, position);
+  }
+
+  if (! pNode) {
+    throw std::out_of_range("List::at");
+  }
+  return pNode;
+}
+
+template<class T, class S>
+typename List<T, S>::Node *List<T, S>::advanceNode(Node *pNode, std::size_t n) const
+{
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    return pSkipIndex->advance(m_pFirstNode, pNode, n);
+  }
+
+  for (; n > 0 && pNode; --n) {
+    pNode = pNode->m_pNextNode;
+  }
+  return pNode;
+}
+
+template<class T, class S>
+LIST_CONSTEXPR void List<T, S>::invalidateSkipIndex()
+{
+  SkipIndex<Node> *pSkipIndex = skipIndex();
+  if (pSkipIndex) {
+    pSkipIndex->invalidate();
+  }
+}
+
+template<class T, class S>
+LIST_CONSTEXPR MonotonicArena *List<T, S>::arena() const
+{
+  return m_pExtension ? m_pExtension->m_pArena : 0;
+}
+
+template<class T, class S>
+LIST_CONSTEXPR SkipIndex<typename List<T, S>::Node> *List<T, S>::skipIndex() const
+{
+  return m_pExtension ? m_pExtension->m_pSkipIndex : 0;
+}
+
+/**
+ * Return the extension of the list, which is allocated by the first feature needing it
+ */
+template<class T, class S>
+typename List<T, S>::Extension &List<T, S>::extension()
+{
+  if (! m_pExtension) {
+    m_pExtension = new Extension;
+  }
+  return *m_pExtension;
+}
+
+/**
+ * Free the extension once the last feature using it is turned off
+ */
+template<class T, class S>
+void List<T, S>::releaseUnusedExtension()
+{
+  if (m_pExtension && ! m_pExtension->isUsed()) {
+    delete m_pExtension;
+    m_pExtension = 0;
+  }
+}
+
+template<class T, class S>
+List<T, S>::Extension::Extension()
+: m_pArena(0),
+  m_pSkipIndex(0)
+{}
+
+/**
+ * The copy shares the arena, and gets a skip index of its own
+ */
+template<class T, class S>
+List<T, S>::Extension::Extension(const Extension &rhs)
+: m_pArena(rhs.m_pArena),
+  m_pSkipIndex(rhs.m_pSkipIndex ? new SkipIndex<Node>(rhs.m_pSkipIndex->stride()) : 0)
+{}
+
+template<class T, class S>
+List<T, S>::Extension::~Extension()
+{
+  delete m_pSkipIndex;
+}
+
+template<class T, class S>
+bool List<T, S>::Extension::isUsed() const
+{
+  return m_pArena || m_pSkipIndex;
 }
 
 #endif
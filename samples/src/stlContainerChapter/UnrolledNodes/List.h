@@ -0,0 +1,470 @@
+/**
+ * Implementation of a list container
+ *   - does not conform to the STL conventions
+ *   - friend iterator comparison operators
+ *   - unrolled nodes: each node stores a small array of values instead of a single one, sized
+ *     at compile time to fill about two cache lines. Traversal therefore only misses the cache
+ *     once per node instead of once per element, while push_front remains O(1)
+ *   - searches (find, count, contains, min, max) scan the values of each node as a block. For
+ *     int and double, blocks are compared with vector instructions (see BlockSearch.h)
+ */
+
+#ifndef LIST_H
+#define LIST_H
+
+#include "BlockSearch.h"
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+template<class T>
+class List {
+private:
+  struct Node;
+
+  // Target size of a node, in bytes (two cache lines of 64 bytes)
+  static const std::size_t s_nodeSize = 128;
+  // Values stored per node. Always at least one, even for very large values
+  static const std::size_t s_nodeCapacity = sizeof(T) < s_nodeSize - 2 * sizeof(void *)
+    ? (s_nodeSize - 2 * sizeof(void *)) / sizeof(T) : 1;
+
+public:
+  class Iterator;
+
+  class ConstIterator {
+  public:
+    ConstIterator();
+    ConstIterator(const Iterator &rhs);
+
+    ConstIterator &operator++();
+    const ConstIterator operator++(int);
+
+    const T *operator->() const;
+    const T &operator*() const;
+
+    friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pNode == rhs.m_pNode && lhs.m_index == rhs.m_index;
+    }
+    friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+    {
+      return lhs.m_pNode != rhs.m_pNode || lhs.m_index != rhs.m_index;
+    }
+
+  private:
+    friend class List;
+
+    ConstIterator(const Node *, std::size_t index);
+
+    const Node *m_pNode;
+    std::size_t m_index;
+  };
+
+  class Iterator {
+  public:
+    Iterator();
+
+    Iterator &operator++();
+    const Iterator operator++(int);
+
+    T *operator->() const;
+    T &operator*() const;
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pNode == rhs.m_pNode && lhs.m_index == rhs.m_index;
+    }
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+    {
+      return lhs.m_pNode != rhs.m_pNode || lhs.m_index != rhs.m_index;
+    }
+  
+  private:
+    friend class List;
+    friend class ConstIterator;
+
+    Iterator(Node *pNode, std::size_t index);
+
+    Node *m_pNode;
+    std::size_t m_index;
+  };
+
+  List();
+  
+  List(const List &rhs);
+  List &operator=(const List &rhs);
+
+  ~List();
+
+  ConstIterator begin() const;
+  Iterator begin();
+
+  ConstIterator end() const;
+  Iterator end();
+
+  void push_front(const T &value);
+
+  ConstIterator find(const T &value) const;
+  Iterator find(const T &value);
+  std::size_t count(const T &value) const;
+  bool contains(const T &value) const;
+
+  ConstIterator min() const;
+  ConstIterator max() const;
+
+private:
+  void createFrom(const List &rhs);
+  void release();
+
+  Node *m_pFirstNode;
+};
+
+/**
+ * Values are stored at the end of the array: slots [m_firstIndex, s_nodeCapacity) are occupied.
+ * The first node is filled from back to front by push_front, all other nodes are full except
+ * when copied from a list whose nodes were not
+ */
+template<class T>
+struct List<T>::Node {
+  explicit Node(Node *pNextNode);
+  ~Node();
+
+  T *value(std::size_t index);
+  const T *value(std::size_t index) const;
+
+  Node *m_pNextNode;
+  std::size_t m_firstIndex;
+  alignas(T) unsigned char m_storage[s_nodeCapacity * sizeof(T)];
+
+private:
+  // Not copyable
+  Node(const Node &rhs);
+  Node &operator=(const Node &rhs);
+};
+
+template<class T>
+List<T>::Node::Node(Node *pNextNode)
+: m_pNextNode(pNextNode),
+  m_firstIndex(s_nodeCapacity)
+{}
+
+template<class T>
+List<T>::Node::~Node()
+{
+  for (std::size_t i = m_firstIndex; i < s_nodeCapacity; ++i) {
+    value(i)->~T();
+  }
+}
+
+template<class T>
+T *List<T>::Node::value(std::size_t index)
+{
+  return static_cast<T *>(static_cast<void *>(m_storage)) + index;
+}
+
+template<class T>
+const T *List<T>::Node::value(std::size_t index) const
+{
+  return static_cast<const T *>(static_cast<const void *>(m_storage)) + index;
+}
+
+template<class T>
+List<T>::ConstIterator::ConstIterator()
+: m_pNode(0),
+  m_index(0)
+{}
+
+template<class T>
+List<T>::ConstIterator::ConstIterator(const Iterator &rhs)
+: m_pNode(rhs.m_pNode),
+  m_index(rhs.m_index)
+{}
+
+template<class T>
+typename List<T>::ConstIterator &List<T>::ConstIterator::operator++()
+{
+  // Past the last slot of a node, continue with the first occupied slot of the next one
+  if (++m_index == s_nodeCapacity) {
+    m_pNode = m_pNode->m_pNextNode;
+    m_index = m_pNode ? m_pNode->m_firstIndex : 0;
+  }
+  return *this;
+}
+
+template<class T>
+const typename List<T>::ConstIterator List<T>::ConstIterator::operator++(int)
+{
+  ConstIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template<class T>
+const T *List<T>::ConstIterator::operator->() const
+{
+  return m_pNode->value(m_index);
+}
+
+template<class T>
+const T &List<T>::ConstIterator::operator*() const
+{
+  return *m_pNode->value(m_index);
+}
+
+template<class T>
+List<T>::ConstIterator::ConstIterator(const Node *pNode, std::size_t index)
+: m_pNode(pNode),
+  m_index(index)
+{}
+
+template<class T>
+List<T>::Iterator::Iterator()
+: m_pNode(0),
+  m_index(0)
+{}
+
+template<class T>
+typename List<T>::Iterator &List<T>::Iterator::operator++()
+{
+  // Past the last slot of a node, continue with the first occupied slot of the next one
+  if (++m_index == s_nodeCapacity) {
+    m_pNode = m_pNode->m_pNextNode;
+    m_index = m_pNode ? m_pNode->m_firstIndex : 0;
+  }
+  return *this;
+}
+
+template<class T>
+const typename List<T>::Iterator List<T>::Iterator::operator++(int)
+{
+  Iterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template<class T>
+T *List<T>::Iterator::operator->() const
+{
+  return m_pNode->value(m_index);
+}
+
+template<class T>
+T &List<T>::Iterator::operator*() const
+{
+  return *m_pNode->value(m_index);
+}
+
+template<class T>
+List<T>::Iterator::Iterator(Node *pNode, std::size_t index)
+: m_pNode(pNode),
+  m_index(index)
+{}
+
+template<class T>
+List<T>::List()
+: m_pFirstNode(0)
+{}
+
+template<class T>
+List<T>::List(const List<T> &rhs)
+: m_pFirstNode(0)
+{
+  createFrom(rhs);
+}
+
+template<class T>
+List<T> &List<T>::operator=(const List<T> &rhs)
+{
+  // Check for self-assignment
+  if (this != &rhs) {
+    release();
+    createFrom(rhs);
+  }
+  return *this;
+}
+
+template<class T>
+List<T>::~List()
+{
+  release();
+}
+
+template<class T>
+typename List<T>::ConstIterator List<T>::begin() const
+{
+  return m_pFirstNode ? ConstIterator(m_pFirstNode, m_pFirstNode->m_firstIndex) : ConstIterator(0, 0);
+}
+
+template<class T>
+typename List<T>::Iterator List<T>::begin()
+{
+  return m_pFirstNode ? Iterator(m_pFirstNode, m_pFirstNode->m_firstIndex) : Iterator(0, 0);
+}
+
+template<class T>
+typename List<T>::ConstIterator List<T>::end() const
+{
+  return ConstIterator(0, 0);
+}
+
+template<class T>
+typename List<T>::Iterator List<T>::end()
+{
+  return Iterator(0, 0);
+}
+
+template<class T>
+void List<T>::push_front(const T &value)
+{
+  // Room left in the first node
+  if (m_pFirstNode && m_pFirstNode->m_firstIndex != 0) {
+    new (m_pFirstNode->value(m_pFirstNode->m_firstIndex - 1)) T(value);
+    --m_pFirstNode->m_firstIndex;
+  }
+  // First node full (or empty list): A new node is needed. It is only linked once the value has
+  // been successfully copied, so that no empty node is ever left in the list
+  else {
+    Node *pNode = new Node(m_pFirstNode);
+    try {
+      new (pNode->value(s_nodeCapacity - 1)) T(value);
+    }
+    catch (...) {
+      delete pNode;
+      throw;
+    }
+    pNode->m_firstIndex = s_nodeCapacity - 1;
+    m_pFirstNode = pNode;
+  }
+}
+
+/**
+ * Return an iterator to the first element equal to value, or end() if there is none
+ */
+template<class T>
+typename List<T>::ConstIterator List<T>::find(const T &value) const
+{
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    std::size_t valueCount = s_nodeCapacity - pNode->m_firstIndex;
+    std::size_t index = blockFind(pNode->value(pNode->m_firstIndex), valueCount, value);
+    if (index != valueCount) {
+      return ConstIterator(pNode, pNode->m_firstIndex + index);
+    }
+  }
+  return end();
+}
+
+template<class T>
+typename List<T>::Iterator List<T>::find(const T &value)
+{
+  ConstIterator it = static_cast<const List<T> &>(*this).find(value);
+  return Iterator(const_cast<Node *>(it.m_pNode), it.m_index);
+}
+
+/**
+ * Return the number of elements equal to value
+ */
+template<class T>
+std::size_t List<T>::count(const T &value) const
+{
+  std::size_t equalCount = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    equalCount += blockCount(pNode->value(pNode->m_firstIndex),
+      s_nodeCapacity - pNode->m_firstIndex, value);
+  }
+  return equalCount;
+}
+
+template<class T>
+bool List<T>::contains(const T &value) const
+{
+  return find(value) != end();
+}
+
+/**
+ * Return an iterator to the first smallest element, or end() if the list is empty
+ */
+template<class T>
+typename List<T>::ConstIterator List<T>::min() const
+{
+  const Node *pMinNode = 0;
+  std::size_t minIndex = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    std::size_t index = pNode->m_firstIndex
+      + blockMin(pNode->value(pNode->m_firstIndex), s_nodeCapacity - pNode->m_firstIndex);
+    if (! pMinNode || *pNode->value(index) < *pMinNode->value(minIndex)) {
+      pMinNode = pNode;
+      minIndex = index;
+    }
+  }
+  return pMinNode ? ConstIterator(pMinNode, minIndex) : end();
+}
+
+/**
+ * Return an iterator to the first largest element, or end() if the list is empty
+ */
+template<class T>
+typename List<T>::ConstIterator List<T>::max() const
+{
+  const Node *pMaxNode = 0;
+  std::size_t maxIndex = 0;
+  for (const Node *pNode = m_pFirstNode; pNode; pNode = pNode->m_pNextNode) {
+    std::size_t index = pNode->m_firstIndex
+      + blockMax(pNode->value(pNode->m_firstIndex), s_nodeCapacity - pNode->m_firstIndex);
+    if (! pMaxNode || *pMaxNode->value(maxIndex) < *pNode->value(index)) {
+      pMaxNode = pNode;
+      maxIndex = index;
+    }
+  }
+  return pMaxNode ? ConstIterator(pMaxNode, maxIndex) : end();
+}
+
+/**
+ * Function factoring out the code for creating a list from an existing one. Must
+ * be called only on an empty list. The node layout of the original list is preserved
+ */
+template<class T>
+void List<T>::createFrom(const List<T> &rhs)
+{
+  // Ensure that the list is empty
+  assert(m_pFirstNode == 0);
+
+  const Node *pRhsNode = rhs.m_pFirstNode;
+  Node *pNode = 0;
+  while (pRhsNode) {
+    // Empty list; create first node
+    if (! m_pFirstNode) {
+      m_pFirstNode = new Node(0);
+      pNode = m_pFirstNode;
+    }
+    // Add following nodes
+    else {
+      pNode->m_pNextNode = new Node(0);
+      pNode = pNode->m_pNextNode;
+    }
+
+    // Copy values from back to front, so that the node always knows which slots need to be
+    // destroyed
+    for (std::size_t i = s_nodeCapacity; i != pRhsNode->m_firstIndex; --i) {
+      new (pNode->value(i - 1)) T(*pRhsNode->value(i - 1));
+      pNode->m_firstIndex = i - 1;
+    }
+    pRhsNode = pRhsNode->m_pNextNode;
+  }
+}
+
+/**
+ * Function factoring out the cleanup code
+ */
+template<class T>
+void List<T>::release()
+{
+  Node *pNode = m_pFirstNode;
+  while (pNode) {
+    Node *pNextNode = pNode->m_pNextNode;
+    delete pNode;
+    pNode = pNextNode;
+  }
+  m_pFirstNode = 0;
+}
+
+#endif
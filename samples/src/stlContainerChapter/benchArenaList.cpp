@@ -0,0 +1,17 @@
+#include "List.h"
+
+#include "ListBenchmark.h"
+
+#include <cstdio>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 10000000);
+
+  std::printf("List<int>\n");
+  benchmarkArenaList<List<int>, int>(maxSize);
+
+  std::printf("\nList<std::string>\n");
+  benchmarkArenaList<List<std::string>, std::string>(maxSize);
+}
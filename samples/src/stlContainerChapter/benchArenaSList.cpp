@@ -0,0 +1,10 @@
+#include "SList.h"
+
+#include "ListBenchmark.h"
+
+#include <string>
+
+int main(int argc, char *argv[])
+{
+  benchmarkArenaList<SList, std::string>(benchmarkMaxSize(argc, argv, 10000000));
+}
@@ -0,0 +1,9 @@
+#include "SList.h"
+
+#include "ListBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+  benchmarkCompaction<SList>(maxSize);
+}
@@ -0,0 +1,95 @@
+#include "ConcurrentSList.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <forward_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Number of push_front / pop_front pairs per measurement, split between threads
+const unsigned s_operations = 1000000;
+
+/**
+ * What the lock-free list replaces: Every operation serialized on a mutex
+ */
+class LockedSList {
+public:
+  void push_front(const std::string &value)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_list.push_front(value);
+  }
+
+  bool pop_front(std::string &value)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_list.empty()) {
+      return false;
+    }
+    value = m_list.front();
+    m_list.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::forward_list<std::string> m_list;
+};
+
+/**
+ * Each thread alternates push_front and pop_front on the shared list. Return the mean wall-clock
+ * time per operation, in nanoseconds
+ */
+template<class ListType>
+double benchmarkThreads(unsigned threadCount)
+{
+  ListType list;
+  std::atomic<bool> go(false);
+  unsigned pairsPerThread = s_operations / threadCount;
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&list, &go, pairsPerThread]() {
+      // Start all threads at once
+      while (! go.load()) {}
+
+      std::string value;
+      for (unsigned i = 0; i < pairsPerThread; ++i) {
+        list.push_front("Value");
+        list.pop_front(value);
+      }
+    }));
+  }
+
+  std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+  go.store(true);
+  for (unsigned t = 0; t < threadCount; ++t) {
+    threads[t].join();
+  }
+  std::chrono::steady_clock::duration elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+  return std::chrono::duration<double, std::nano>(elapsedTime).count() / (2.0 * pairsPerThread * threadCount);
+}
+
+}
+
+/**
+ * The largest number of threads can be given as first command-line argument
+ */
+int main(int argc, char *argv[])
+{
+  unsigned maxThreadCount = argc >= 2 ? static_cast<unsigned>(std::strtoul(argv[1], 0, 10)) : 64;
+
+  std::printf("%-10s %18s %18s\n", "threads", "lock-free ns/op", "mutex ns/op");
+  for (unsigned threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+    double lockFreeTime = benchmarkThreads<ConcurrentSList>(threadCount);
+    double lockedTime = benchmarkThreads<LockedSList>(threadCount);
+    std::printf("%-10u %18.2f %18.2f\n", threadCount, lockFreeTime, lockedTime);
+  }
+}
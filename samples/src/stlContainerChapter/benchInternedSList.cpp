@@ -0,0 +1,124 @@
+#include "SList.h"
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <forward_list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The elements are spread over lists of this length (or a single shorter list), drawing their
+// values from a vocabulary of host names, long enough to require heap allocations of their own in
+// a std::string
+const std::size_t s_listLength = 100;
+const std::size_t s_vocabularySize = 1000;
+const std::size_t s_firstSize = 10000;
+
+struct Measurement {
+  double m_bytesPerElement;
+  double m_copyNanoseconds;
+};
+
+std::vector<std::string> makeVocabulary()
+{
+  std::vector<std::string> vocabulary;
+  vocabulary.reserve(s_vocabularySize);
+  for (std::size_t i = 0; i < s_vocabularySize; ++i) {
+    vocabulary.push_back("host-" + std::to_string(i) + ".eu-west-1.compute.example.com");
+  }
+  return vocabulary;
+}
+
+/**
+ * Measure push_front, copy and comparison of size elements, copied from emptyList. The memory
+ * held by the lists and their copies is what push_front and the copies allocated, pool included
+ */
+template<class ListType>
+Measurement benchmarkRepeatedValues(const char *name, std::size_t size,
+  const std::vector<std::string> &vocabulary, const ListType &emptyList)
+{
+  std::size_t listLength = std::min(s_listLength, size);
+  std::size_t listCount = size / listLength;
+  // Only whole lists are measured
+  size = listCount * listLength;
+  std::vector<ListType> lists(listCount, emptyList);
+  std::vector<ListType> copies;
+  copies.reserve(listCount);
+  std::minstd_rand random;
+  BenchmarkCounters counters;
+  std::string operation;
+  Measurement measurement;
+
+  counters.start();
+  for (std::size_t l = 0; l < listCount; ++l) {
+    for (std::size_t i = 0; i < listLength; ++i) {
+      lists[l].push_front(vocabulary[random() % vocabulary.size()]);
+    }
+  }
+  counters.stop();
+  std::size_t allocatedBytes = counters.allocatedBytes();
+  operation = std::string("push_front ") + name;
+  printBenchmarkResult(operation.c_str(), size, size, counters);
+
+  counters.start();
+  for (std::size_t l = 0; l < listCount; ++l) {
+    copies.push_back(lists[l]);
+  }
+  counters.stop();
+  allocatedBytes += counters.allocatedBytes();
+  measurement.m_bytesPerElement = static_cast<double>(allocatedBytes) / size;
+  measurement.m_copyNanoseconds = counters.elapsedNanoseconds() / size;
+  operation = std::string("copy ") + name;
+  printBenchmarkResult(operation.c_str(), size, size, counters);
+
+  counters.start();
+  std::size_t equalCount = 0;
+  for (std::size_t l = 0; l < listCount; ++l) {
+    equalCount += copies[l] == lists[l];
+  }
+  counters.stop();
+  doNotOptimize(equalCount);
+  operation = std::string("equality ") + name;
+  printBenchmarkResult(operation.c_str(), size, size, counters);
+
+  return measurement;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+  std::vector<std::string> vocabulary = makeVocabulary();
+  std::vector<Measurement> plainMeasurements;
+  std::vector<Measurement> internedMeasurements;
+
+  printBenchmarkHeader();
+  // Start below s_firstSize if the maximum size asks for it, so that something is measured
+  std::size_t firstSize = std::min(s_firstSize, maxSize);
+  for (std::size_t size = firstSize; size <= maxSize; size *= 10) {
+    plainMeasurements.push_back(benchmarkRepeatedValues("std::string", size, vocabulary,
+      std::forward_list<std::string>()));
+    // A new pool for each size, so that its memory is accounted for every time
+    StringPool pool;
+    internedMeasurements.push_back(benchmarkRepeatedValues("interned", size, vocabulary,
+      SList(pool)));
+  }
+
+  std::printf("\n%-10s %16s %16s %12s %12s\n", "size", "bytes/element", "bytes/element",
+    "memory", "copy");
+  std::printf("%-10s %16s %16s %12s %12s\n", "", "std::string", "interned", "saved", "speedup");
+  std::size_t size = firstSize;
+  for (std::size_t i = 0; i < plainMeasurements.size(); ++i, size *= 10) {
+    const Measurement &plain = plainMeasurements[i];
+    const Measurement &interned = internedMeasurements[i];
+    std::printf("%-10zu %16.1f %16.1f %11.1f%% %11.2fx\n", size, plain.m_bytesPerElement,
+      interned.m_bytesPerElement,
+      100.0 * (1.0 - interned.m_bytesPerElement / plain.m_bytesPerElement),
+      plain.m_copyNanoseconds / interned.m_copyNanoseconds);
+  }
+}
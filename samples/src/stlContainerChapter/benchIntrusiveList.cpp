@@ -0,0 +1,113 @@
+#include "List.h"
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <forward_list>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Object {
+  std::string m_name;
+  ListHook<Object> m_hook;
+};
+
+typedef List<Object, &Object::m_hook> IntrusiveList;
+typedef std::forward_list<Object> CopyingList;
+
+// Small lists are measured several times over, so that each measurement covers about the same
+// number of elements
+const std::size_t s_elementsPerMeasurement = 1000000;
+
+/**
+ * Link the objects in an intrusive list, traverse it and unlink them, against the same with a
+ * list storing copies of the objects
+ */
+void benchmarkSize(std::vector<Object> &objects, std::size_t repetitions)
+{
+  std::size_t size = objects.size();
+  std::size_t operations = repetitions * size;
+  BenchmarkCounters counters;
+  std::size_t length = 0;
+
+  {
+    std::vector<IntrusiveList> lists(repetitions);
+    std::vector<std::vector<Object> > pools(repetitions, objects);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      for (std::size_t i = 0; i < size; ++i) {
+        lists[r].push_front(pools[r][i]);
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("push_front (intrusive)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      const IntrusiveList &list = lists[r];
+      for (IntrusiveList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+        length += cit->m_name.size();
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("traversal (intrusive)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      lists[r].clear();
+    }
+    counters.stop();
+    printBenchmarkResult("clear (intrusive)", size, operations, counters);
+  }
+
+  {
+    std::vector<CopyingList> lists(repetitions);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      for (std::size_t i = 0; i < size; ++i) {
+        lists[r].push_front(objects[i]);
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("push_front (copying)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      const CopyingList &list = lists[r];
+      for (CopyingList::const_iterator cit = list.begin(); cit != list.end(); ++cit) {
+        length += cit->m_name.size();
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("traversal (copying)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      lists[r].clear();
+    }
+    counters.stop();
+    printBenchmarkResult("clear (copying)", size, operations, counters);
+  }
+
+  doNotOptimize(length);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::vector<Object> objects(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      objects[i].m_name = std::to_string(i % 1000000);
+    }
+    benchmarkSize(objects, size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1);
+  }
+}
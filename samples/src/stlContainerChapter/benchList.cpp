@@ -0,0 +1,15 @@
+#include "List.h"
+
+#include "ListBenchmark.h"
+
+#include <cstdio>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 10000000);
+  benchmarkList<List<std::string> >(maxSize);
+
+  std::printf("\n");
+  benchmarkScatteredList<List<std::string> >(maxSize);
+}
@@ -0,0 +1,85 @@
+#include "List.h"
+#include "ListFile.h"
+
+#include "ListBenchmark.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+const char *const s_textFileName = "benchListFile.txt";
+const char *const s_listFileName = "benchListFile.list";
+
+}
+
+/**
+ * Compare reloading a list of strings from a text file, one value per line, with opening the
+ * same list in a binary list file and traversing it in place
+ */
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::size_t repetitions = size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1;
+    std::size_t operations = repetitions * size;
+
+    List<std::string> list;
+    std::string value;
+    for (std::size_t i = 0; i < size; ++i) {
+      makeBenchmarkValue(i, value);
+      list.push_front(value);
+    }
+
+    BenchmarkCounters counters;
+    counters.start();
+    {
+      std::ofstream textFile(s_textFileName);
+      for (List<std::string>::ConstIterator it = list.begin(); it != list.end(); ++it) {
+        textFile << *it << '\n';
+      }
+    }
+    counters.stop();
+    printBenchmarkResult("write (text)", size, size, counters);
+
+    counters.start();
+    {
+      ListWriter<std::string> writer(s_listFileName);
+      writer.write(list.begin(), list.end());
+      writer.finish();
+    }
+    counters.stop();
+    printBenchmarkResult("write (list file)", size, size, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      List<std::string> loadedList;
+      std::ifstream textFile(s_textFileName);
+      while (std::getline(textFile, value)) {
+        loadedList.push_front(value);
+      }
+      doNotOptimize(loadedList.begin()->size());
+    }
+    counters.stop();
+    printBenchmarkResult("load+traverse (text)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      MappedList<std::string> mappedList(s_listFileName);
+      std::size_t length = 0;
+      for (MappedList<std::string>::ConstIterator it = mappedList.begin(); it != mappedList.end();
+        ++it) {
+        length += it->size();
+      }
+      doNotOptimize(length);
+    }
+    counters.stop();
+    printBenchmarkResult("open+traverse (mapped)", size, operations, counters);
+  }
+
+  std::remove(s_textFileName);
+  std::remove(s_listFileName);
+}
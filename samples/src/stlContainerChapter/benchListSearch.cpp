@@ -0,0 +1,89 @@
+#include "List.h"
+
+#include "Benchmark.h"
+
+#include <cstdio>
+
+namespace {
+
+// Searches are repeated so that each measurement covers about the same number of elements
+const std::size_t s_elementsPerMeasurement = 10000000;
+
+/**
+ * Measure find (of a value which is not in the list, so that the whole list is scanned), count,
+ * min and max, against the same find written as an iterator loop
+ */
+template<class T>
+void benchmarkListSearch(std::size_t maxSize)
+{
+  typedef typename List<T>::ConstIterator ConstIterator;
+
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    std::size_t repetitions = size < s_elementsPerMeasurement ? s_elementsPerMeasurement / size : 1;
+    std::size_t operations = repetitions * size;
+
+    List<T> list;
+    for (std::size_t i = 0; i < size; ++i) {
+      list.push_front(static_cast<T>(i % 1000));
+    }
+    const List<T> &constList = list;
+    const T missingValue = static_cast<T>(-1);
+
+    BenchmarkCounters counters;
+    std::size_t result = 0;
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      ConstIterator it = constList.begin();
+      while (it != constList.end() && ! (*it == missingValue)) {
+        ++it;
+      }
+      result += it == constList.end();
+    }
+    counters.stop();
+    printBenchmarkResult("find (iterator loop)", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      result += constList.find(missingValue) == constList.end();
+    }
+    counters.stop();
+    printBenchmarkResult("find", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      result += list.count(static_cast<T>(r % 1000));
+    }
+    counters.stop();
+    printBenchmarkResult("count", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      result += static_cast<std::size_t>(*list.min());
+    }
+    counters.stop();
+    printBenchmarkResult("min", size, operations, counters);
+
+    counters.start();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      result += static_cast<std::size_t>(*list.max());
+    }
+    counters.stop();
+    printBenchmarkResult("max", size, operations, counters);
+
+    doNotOptimize(result);
+  }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+
+  std::printf("List<int>\n");
+  benchmarkListSearch<int>(maxSize);
+
+  std::printf("\nList<double>\n");
+  benchmarkListSearch<double>(maxSize);
+}
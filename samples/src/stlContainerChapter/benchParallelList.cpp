@@ -0,0 +1,104 @@
+#include "List.h"
+#include "ParallelList.h"
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+typedef List<int> IntList;
+
+// The sum of the elements does not fit in an int
+long long addValues(long long lhs, int rhs)
+{
+  return lhs + rhs;
+}
+
+bool isEven(int value)
+{
+  return value % 2 == 0;
+}
+
+void increment(int &value)
+{
+  ++value;
+}
+
+/**
+ * Measure function(), which processes the size elements of the list once
+ */
+template<class Function>
+void measure(const char *operation, std::size_t size, Function function)
+{
+  BenchmarkCounters counters;
+  counters.start();
+  function();
+  counters.stop();
+  printBenchmarkResult(operation, size, size, counters);
+}
+
+}
+
+/**
+ * The list size and the largest number of threads can be given as first and second command-line
+ * arguments
+ */
+int main(int argc, char *argv[])
+{
+  std::size_t size = benchmarkMaxSize(argc, argv, 10000000);
+  std::size_t maxThreadCount = argc >= 3 ? std::strtoul(argv[2], 0, 10) : defaultThreadCount();
+
+  IntList list;
+  for (std::size_t i = 0; i < size; ++i) {
+    list.push_front(static_cast<int>(i));
+  }
+
+  printBenchmarkHeader();
+
+  // Built twice, so that the measurement does not include the first touch of the nodes
+  ListPartition<IntList::Iterator> partition(list.begin(), list.end());
+  measure("partition", size, [&]() {
+    partition = ListPartition<IntList::Iterator>(list.begin(), list.end());
+  });
+
+  // Serial loops, as a baseline
+  measure("for_each serial", size, [&]() {
+    for (IntList::Iterator it = list.begin(); it != list.end(); ++it) {
+      increment(*it);
+    }
+  });
+  measure("reduce serial", size, [&]() {
+    long long sum = 0;
+    for (IntList::Iterator it = list.begin(); it != list.end(); ++it) {
+      sum = addValues(sum, *it);
+    }
+    doNotOptimize(static_cast<std::size_t>(sum));
+  });
+  measure("count_if serial", size, [&]() {
+    std::size_t count = 0;
+    for (IntList::Iterator it = list.begin(); it != list.end(); ++it) {
+      count += isEven(*it);
+    }
+    doNotOptimize(count);
+  });
+
+  char operation[32];
+  for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+    unsigned long threads = static_cast<unsigned long>(threadCount);
+    std::snprintf(operation, sizeof(operation), "for_each %lu threads", threads);
+    measure(operation, size, [&]() {
+      parallel_for_each(partition, increment, threadCount);
+    });
+    std::snprintf(operation, sizeof(operation), "reduce %lu threads", threads);
+    measure(operation, size, [&]() {
+      doNotOptimize(static_cast<std::size_t>(parallel_reduce(partition, 0LL, addValues,
+        threadCount)));
+    });
+    std::snprintf(operation, sizeof(operation), "count_if %lu threads", threads);
+    measure(operation, size, [&]() {
+      doNotOptimize(parallel_count_if(partition, isEven, threadCount));
+    });
+  }
+}
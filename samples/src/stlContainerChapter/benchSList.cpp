@@ -0,0 +1,14 @@
+#include "SList.h"
+
+#include "ListBenchmark.h"
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 10000000);
+  benchmarkList<SList>(maxSize);
+
+  std::printf("\n");
+  benchmarkScatteredList<SList>(maxSize);
+}
@@ -0,0 +1,88 @@
+#include "SList.h"
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Number of lookups per measurement. Half of them hit
+const std::size_t s_lookupCount = 10000;
+
+/**
+ * Measure push_front, contains, copy and erasure of size elements, with or without a hash index
+ */
+void benchmarkHashIndex(std::size_t size, bool isIndexed)
+{
+  std::vector<std::string> values;
+  values.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    values.push_back("value" + std::to_string(i));
+  }
+  std::vector<std::string> lookups;
+  lookups.reserve(s_lookupCount);
+  for (std::size_t i = 0; i < s_lookupCount; ++i) {
+    lookups.push_back(i % 2 ? values[i * 7919 % size] : "missing" + std::to_string(i));
+  }
+
+  BenchmarkCounters counters;
+  SList list;
+  // The index is built when it is enabled, so that push_front measures its maintenance
+  list.setHashIndexEnabled(isIndexed);
+  counters.start();
+  for (std::size_t i = 0; i < size; ++i) {
+    list.push_front(values[i]);
+  }
+  counters.stop();
+  printBenchmarkResult(isIndexed ? "push_front (indexed)" : "push_front", size, size, counters);
+
+  counters.start();
+  std::size_t hits = 0;
+  for (std::size_t i = 0; i < s_lookupCount; ++i) {
+    hits += list.contains(lookups[i]);
+  }
+  counters.stop();
+  doNotOptimize(hits);
+  printBenchmarkResult(isIndexed ? "contains (indexed)" : "contains", size, s_lookupCount,
+    counters);
+
+  counters.start();
+  {
+    SList copy(list);
+    doNotOptimize(copy.contains(values[0]));
+  }
+  counters.stop();
+  printBenchmarkResult(isIndexed ? "copy+lookup (indexed)" : "copy+lookup", size, size, counters);
+
+  counters.start();
+  for (std::size_t i = 0; i < size; ++i) {
+    list.pop_front();
+  }
+  counters.stop();
+  printBenchmarkResult(isIndexed ? "pop_front (indexed)" : "pop_front", size, size, counters);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 100000);
+  printBenchmarkHeader();
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    benchmarkHashIndex(size, false);
+    benchmarkHashIndex(size, true);
+  }
+
+  std::printf("\nsize        index bytes  bytes/element\n");
+  for (std::size_t size = 10; size <= maxSize; size *= 10) {
+    SList list;
+    list.setHashIndexEnabled(true);
+    for (std::size_t i = 0; i < size; ++i) {
+      list.push_front(std::to_string(i));
+    }
+    std::printf("%-10zu  %11zu  %13.1f\n", size, list.hashIndexMemoryUsage(),
+      static_cast<double>(list.hashIndexMemoryUsage()) / size);
+  }
+}
@@ -0,0 +1,11 @@
+#include "List.h"
+
+#include "ListBenchmark.h"
+
+#include <string>
+
+int main(int argc, char *argv[])
+{
+  std::size_t maxSize = benchmarkMaxSize(argc, argv, 1000000);
+  benchmarkStackList<List<std::string> >(maxSize);
+}
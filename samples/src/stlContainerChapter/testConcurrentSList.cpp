@@ -0,0 +1,60 @@
+#include "ConcurrentSList.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void testConcurrentSList()
+{
+  ConcurrentSList list;
+
+  list.push_front("Alice");
+  list.push_front("Bob");
+  list.push_front("Copernicus");
+
+  std::string value;
+  while (list.pop_front(value)) {
+    std::cout << value << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void testSharedConcurrentSList()
+{
+  const unsigned threadCount = 4;
+  const unsigned valuesPerThread = 10000;
+
+  ConcurrentSList list;
+
+  // Each thread pushes its values and pops as many, though not necessarily its own
+  std::vector<std::thread> threads;
+  std::vector<unsigned> popCounts(threadCount, 0);
+  for (unsigned t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&list, &popCounts, t]() {
+      std::string value;
+      for (unsigned i = 0; i < valuesPerThread; ++i) {
+        list.push_front("Value");
+        if (list.pop_front(value)) {
+          ++popCounts[t];
+        }
+      }
+    }));
+  }
+  for (unsigned t = 0; t < threadCount; ++t) {
+    threads[t].join();
+  }
+
+  unsigned popCount = 0;
+  for (unsigned t = 0; t < threadCount; ++t) {
+    popCount += popCounts[t];
+  }
+  std::cout << threadCount * valuesPerThread << " pushed, " << popCount << " popped, "
+    << (list.empty() ? "empty" : "not empty") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testConcurrentSList();
+  testSharedConcurrentSList();
+}
@@ -0,0 +1,90 @@
+#include "List.h"
+#include "ListTable.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+
+/**
+ * Lists built, copied, sorted, merged and searched at compile time. None of them survives the
+ * evaluation: Only the tables copied from them do
+ */
+constexpr int sumOfSortedMerge()
+{
+  List<int> odds;
+  List<int> evens;
+  for (int i = 0; i < 10; ++i) {
+    (i % 2 ? odds : evens).push_front(i);
+  }
+  odds.sort();
+  evens.sort();
+
+  List<int> copy(odds);
+  copy.merge(evens);
+
+  int sum = 0;
+  int previous = -1;
+  for (List<int>::ConstIterator cit = copy.begin(); cit != copy.end(); ++cit) {
+    if (*cit < previous) {
+      return -1;
+    }
+    previous = *cit;
+    sum += *cit;
+  }
+  return copy.contains(7) && copy.count(3) == 1 && *copy.max() == 9 ? sum : -1;
+}
+
+static_assert(sumOfSortedMerge() == 45);
+
+// Configuration keys, sorted at compile time so that they can be binary searched at run time
+typedef List<std::string_view> KeyList;
+
+constexpr auto fillKeys = [](KeyList &keys) {
+  const std::string_view values[] = {
+    "network.timeout", "cache.size", "log.level", "network.retries", "cache.policy", "log.file"
+  };
+  keys.push_front(values, values + sizeof(values) / sizeof(values[0]));
+  keys.sort();
+};
+
+constexpr auto s_keys = makeListTable<KeyList, listTableSize<KeyList>(fillKeys)>(fillKeys);
+
+static_assert(s_keys.size() == 6);
+static_assert(s_keys.front() == "cache.policy" && s_keys.back() == "network.timeout");
+
+// Squares of the first primes, in decreasing order since elements are pushed at the front
+constexpr auto fillPrimeSquares = [](List<int> &squares) {
+  for (int n = 2; n < 30; ++n) {
+    bool isPrime = true;
+    for (int d = 2; d * d <= n; ++d) {
+      isPrime = isPrime && n % d != 0;
+    }
+    if (isPrime) {
+      squares.push_front(n * n);
+    }
+  }
+};
+
+constexpr auto s_primeSquares
+  = makeListTable<List<int>, listTableSize<List<int> >(fillPrimeSquares)>(fillPrimeSquares);
+
+static_assert(s_primeSquares.size() == 10 && s_primeSquares.front() == 29 * 29);
+
+int main(int argc, char *argv[])
+{
+  for (std::size_t i = 0; i < s_keys.size(); ++i) {
+    std::cout << s_keys[i] << " ";
+  }
+  std::cout << std::endl;
+
+  const char *lookups[] = { "log.level", "log.size" };
+  for (std::size_t i = 0; i < 2; ++i) {
+    bool found = std::binary_search(s_keys.begin(), s_keys.end(), std::string_view(lookups[i]));
+    std::cout << lookups[i] << (found ? " found" : " not found") << std::endl;
+  }
+
+  for (std::size_t i = 0; i < s_primeSquares.size(); ++i) {
+    std::cout << s_primeSquares[i] << " ";
+  }
+  std::cout << std::endl;
+}
@@ -0,0 +1,76 @@
+#include "SList.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void printLookup(const SList &list, const std::string &value)
+{
+  SList::ConstIterator cit = list.find(value);
+  std::cout << value << ": " << (cit != list.end() ? "found " + *cit : "not found") << std::endl;
+}
+
+void testInternedSList()
+{
+  StringPool pool;
+  SList list(pool);
+  list.push_front("Alice");
+  list.push_front(std::string("Bob"));
+  list.push_front("A string too long to fit in the std::string small buffer");
+  list.push_front("Alice");
+
+  for (SList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " (" << cit->size() << ")" << std::endl;
+  }
+  std::cout << "distinct values: " << pool.size() << std::endl;
+
+  // The copy shares the values of the original, element for element
+  SList copy(list);
+  std::cout << "same value: " << (&*copy.begin() == &*list.begin()) << std::endl;
+  std::cout << "equal: " << (copy == list) << std::endl;
+  copy.pop_front();
+  std::cout << "equal after pop_front: " << (copy == list) << std::endl;
+
+  printLookup(copy, "Bob");
+  printLookup(copy, "Carol");
+  std::cout << "distinct values: " << pool.size() << std::endl;
+
+  // Lists of different pools compare their values
+  SList other;
+  other.push_front("Alice");
+  SList single(pool);
+  single.push_front("Alice");
+  std::cout << "equal across pools: " << (other == single) << std::endl;
+}
+
+/**
+ * Threads fill their own lists from the same values: Each value is still interned once
+ */
+void testConcurrentInterning()
+{
+  StringPool pool;
+  std::vector<SList> lists(4, SList(pool));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < lists.size(); ++t) {
+    SList &list = lists[t];
+    threads.push_back(std::thread([&list]() {
+      for (int i = 0; i < 10000; ++i) {
+        list.push_front("value" + std::to_string(i % 100));
+      }
+    }));
+  }
+  for (std::size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+
+  std::cout << "distinct values: " << pool.size() << std::endl;
+  std::cout << "lists equal: " << (lists[0] == lists[lists.size() - 1]) << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testInternedSList();
+  std::cout << std::endl;
+  testConcurrentInterning();
+}
@@ -0,0 +1,61 @@
+#include "List.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+struct Scientist {
+  explicit Scientist(const std::string &name);
+
+  std::string m_name;
+
+  // One hook per list the object can be linked in
+  ListHook<Scientist> m_allHook;
+  ListHook<Scientist> m_selectedHook;
+};
+
+Scientist::Scientist(const std::string &name)
+: m_name(name)
+{}
+
+}
+
+void testIntrusiveList()
+{
+  typedef List<Scientist, &Scientist::m_allHook> AllList;
+  typedef List<Scientist, &Scientist::m_selectedHook> SelectedList;
+
+  // The objects live outside of the lists
+  Scientist scientists[] = { Scientist("Alice"), Scientist("Bob"), Scientist("Copernicus") };
+
+  AllList all;
+  SelectedList selected;
+  for (Scientist *pScientist = scientists; pScientist != scientists + 3; ++pScientist) {
+    all.push_front(*pScientist);
+  }
+  selected.push_front(scientists[2]);
+  selected.push_front(scientists[0]);
+
+  for (AllList::ConstIterator cit = all.begin(); cit != all.end(); ++cit) {
+    std::cout << cit->m_name << std::endl;
+  }
+  std::cout << std::endl;
+
+  for (SelectedList::Iterator it = selected.begin(); it != selected.end(); ++it) {
+    it->m_name += " (selected)";
+  }
+  for (AllList::ConstIterator cit = all.begin(); cit != all.end(); ++cit) {
+    std::cout << cit->m_name << std::endl;
+  }
+  std::cout << std::endl;
+
+  // Unlink the objects, without destroying them
+  selected.clear();
+  all.clear();
+}
+
+int main(int argc, char *argv[])
+{
+  testIntrusiveList();
+}
@@ -0,0 +1,175 @@
+#include "List.h"
+#include "ListFile.h"
+
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+void testStringListFile()
+{
+  List<std::string> list;
+  list.push_front("third");
+  list.push_front("");
+  list.push_front("first");
+
+  ListWriter<std::string> writer("strings.list");
+  writer.write(list.begin(), list.end());
+  writer.finish();
+
+  MappedList<std::string> mappedList("strings.list");
+  std::cout << mappedList.size() << " strings:";
+  for (MappedList<std::string>::ConstIterator it = mappedList.begin(); it != mappedList.end();
+    ++it) {
+    std::cout << " \"" << *it << "\" (" << it->size() << ")";
+  }
+  std::cout << std::endl;
+  std::cout << "at(2): " << mappedList.at(2) << std::endl;
+
+  std::remove("strings.list");
+}
+
+void testIntListFile()
+{
+  List<int> list;
+  for (int i = 0; i < 5; ++i) {
+    list.push_front(i * i);
+  }
+
+  ListWriter<int> writer("ints.list");
+  writer.write(list.begin(), list.end());
+  writer.finish();
+
+  MappedList<int> mappedList("ints.list");
+  std::cout << mappedList.size() << " ints:";
+  for (MappedList<int>::ConstIterator it = mappedList.begin(); it != mappedList.end(); ++it) {
+    std::cout << " " << *it;
+  }
+  std::cout << std::endl;
+
+  try {
+    mappedList.at(5);
+  }
+  catch (const std::out_of_range &) {
+    std::cout << "at(5) is out of range" << std::endl;
+  }
+
+  // A list file of ints is not a list file of strings
+  try {
+    MappedList<std::string> stringList("ints.list");
+  }
+  catch (const std::runtime_error &exception) {
+    std::cout << exception.what() << std::endl;
+  }
+
+  std::remove("ints.list");
+}
+
+void testEmptyListFile()
+{
+  ListWriter<std::string> writer("empty.list");
+  writer.finish();
+
+  MappedList<std::string> mappedList("empty.list");
+  std::cout << mappedList.size() << " strings, "
+    << (mappedList.begin() == mappedList.end() ? "empty" : "not empty") << std::endl;
+
+  std::remove("empty.list");
+}
+
+/**
+ * Overwrite an entry of the offset table with an offset past the end of the file
+ */
+void corruptRecordOffset(const char *fileName, std::size_t position)
+{
+  std::FILE *pFile = std::fopen(fileName, "r+b");
+  ListFileHeader header;
+  std::uint64_t offset = 1 << 30;
+  long entryOffset = 0;
+  if (pFile && std::fread(&header, sizeof(header), 1, pFile) == 1) {
+    entryOffset = static_cast<long>(header.m_tableOffset + position * sizeof(offset));
+  }
+  if (! pFile || entryOffset == 0 || std::fseek(pFile, entryOffset, SEEK_SET) != 0
+    || std::fwrite(&offset, sizeof(offset), 1, pFile) != 1) {
+    std::cout << "cannot corrupt " << fileName << std::endl;
+  }
+  if (pFile) {
+    std::fclose(pFile);
+  }
+}
+
+/**
+ * Overwrite the length prefix of the first record with a length past the end of the file
+ */
+void corruptFirstRecordLength(const char *fileName)
+{
+  std::FILE *pFile = std::fopen(fileName, "r+b");
+  ListFileHeader header;
+  std::uint32_t length = 1 << 30;
+  long recordOffset = 0;
+  if (pFile && std::fread(&header, sizeof(header), 1, pFile) == 1) {
+    recordOffset = static_cast<long>(header.m_payloadOffset);
+  }
+  if (! pFile || recordOffset == 0 || std::fseek(pFile, recordOffset, SEEK_SET) != 0
+    || std::fwrite(&length, sizeof(length), 1, pFile) != 1) {
+    std::cout << "cannot corrupt " << fileName << std::endl;
+  }
+  if (pFile) {
+    std::fclose(pFile);
+  }
+}
+
+void testCorruptListFile()
+{
+  ListWriter<std::string> writer("corrupt.list");
+  writer.write("first");
+  writer.write("second");
+  writer.finish();
+
+  // Only the entries which are used are checked: The first one by at(0), the last one on opening
+  corruptRecordOffset("corrupt.list", 0);
+  try {
+    MappedList<std::string> mappedList("corrupt.list");
+    std::cout << "at(1): " << mappedList.at(1) << std::endl;
+    mappedList.at(0);
+  }
+  catch (const std::runtime_error &exception) {
+    std::cout << exception.what() << std::endl;
+  }
+
+  corruptRecordOffset("corrupt.list", 1);
+  try {
+    MappedList<std::string> mappedList("corrupt.list");
+  }
+  catch (const std::runtime_error &exception) {
+    std::cout << exception.what() << std::endl;
+  }
+
+  // The table is intact, so opening and at() succeed: Iterating stops at the corrupt length
+  ListWriter<std::string> rewriter("corrupt.list");
+  rewriter.write("first");
+  rewriter.write("second");
+  rewriter.finish();
+  corruptFirstRecordLength("corrupt.list");
+  try {
+    MappedList<std::string> mappedList("corrupt.list");
+    std::cout << "at(1): " << mappedList.at(1) << std::endl;
+    for (MappedList<std::string>::ConstIterator cit = mappedList.begin();
+      cit != mappedList.end(); ++cit) {
+      std::cout << *cit << std::endl;
+    }
+  }
+  catch (const std::runtime_error &exception) {
+    std::cout << exception.what() << std::endl;
+  }
+
+  std::remove("corrupt.list");
+}
+
+int main(int argc, char *argv[])
+{
+  testStringListFile();
+  testIntListFile();
+  testEmptyListFile();
+  testCorruptListFile();
+}
@@ -0,0 +1,45 @@
+#include "List.h"
+
+#include <iostream>
+
+void printList(const List<int> &list)
+{
+  for (List<int>::ConstIterator it = list.begin(); it != list.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << std::endl;
+}
+
+void testListRecycling()
+{
+  List<int> list;
+  for (int i = 5; i > 0; --i) {
+    list.push_front(i);
+  }
+  printList(list);
+
+  // Insert 10 after 2, then erase 3
+  List<int>::Iterator it = list.insert_after(list.find(2), 10);
+  it = list.erase_after(it);
+  printList(list);
+
+  // Erase everything between the first and the last element
+  list.erase_after(list.begin(), list.find(5));
+  printList(list);
+
+  // Used as a stack: The nodes popped are reused by the next pushes
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      list.push_front(i);
+    }
+    while (list.begin() != list.end()) {
+      list.pop_front();
+    }
+  }
+  printList(list);
+}
+
+int main(int argc, char *argv[])
+{
+  testListRecycling();
+}
@@ -0,0 +1,76 @@
+#include "List.h"
+
+#include <iostream>
+#include <random>
+
+/**
+ * Check find, count, contains, min and max against plain iterator loops, on lists of random
+ * values of every length up to maxSize. Return the number of mismatches
+ */
+template<class T>
+int checkListSearch(std::size_t maxSize)
+{
+  typedef typename List<T>::ConstIterator ConstIterator;
+
+  int errorCount = 0;
+  std::minstd_rand random;
+  for (std::size_t size = 0; size <= maxSize; ++size) {
+    List<T> list;
+    for (std::size_t i = 0; i < size; ++i) {
+      list.push_front(static_cast<T>(random() % 50) - 25);
+    }
+
+    for (int v = -26; v <= 25; ++v) {
+      T value = static_cast<T>(v);
+      ConstIterator expectedFound = list.end();
+      std::size_t expectedCount = 0;
+      for (ConstIterator it = list.begin(); it != list.end(); ++it) {
+        if (*it == value) {
+          if (expectedFound == list.end()) {
+            expectedFound = it;
+          }
+          ++expectedCount;
+        }
+      }
+      const List<T> &constList = list;
+      if (constList.find(value) != expectedFound || list.count(value) != expectedCount
+        || list.contains(value) != (expectedCount != 0)) {
+        ++errorCount;
+      }
+    }
+
+    ConstIterator expectedMin = list.begin();
+    ConstIterator expectedMax = list.begin();
+    for (ConstIterator it = list.begin(); it != list.end(); ++it) {
+      if (*it < *expectedMin) {
+        expectedMin = it;
+      }
+      if (*expectedMax < *it) {
+        expectedMax = it;
+      }
+    }
+    if (list.min() != expectedMin || list.max() != expectedMax) {
+      ++errorCount;
+    }
+  }
+  return errorCount;
+}
+
+void testListSearch()
+{
+  List<int> list;
+  for (int i = 0; i < 100; ++i) {
+    list.push_front(i % 7);
+  }
+  std::cout << "count(3): " << list.count(3) << ", contains(7): " << list.contains(7)
+    << ", min: " << *list.min() << ", max: " << *list.max() << std::endl;
+
+  std::cout << "List<int>: " << checkListSearch<int>(200) << " errors" << std::endl;
+  std::cout << "List<double>: " << checkListSearch<double>(200) << " errors" << std::endl;
+  std::cout << "List<short>: " << checkListSearch<short>(200) << " errors" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testListSearch();
+}
@@ -0,0 +1,86 @@
+#include "List.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Compare at() and advance() with a plain walk of the list, from every position and for every
+ * distance up to past the end. Return the number of mismatches
+ */
+std::size_t checkPositions(List<int> &list)
+{
+  std::vector<List<int>::Iterator> walk;
+  for (List<int>::Iterator it = list.begin(); it != list.end(); ++it) {
+    walk.push_back(it);
+  }
+
+  const List<int> &constList = list;
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    mismatches += &list.at(i) != &*walk[i] || &constList.at(i) != &*walk[i];
+    for (std::size_t n = 0; i + n <= walk.size() + 1; ++n) {
+      List<int>::Iterator expected = i + n < walk.size() ? walk[i + n] : list.end();
+      mismatches += list.advance(walk[i], n) != expected
+        || constList.advance(walk[i], n) != expected;
+    }
+  }
+
+  try {
+    constList.at(walk.size());
+    ++mismatches;
+  }
+  catch (const std::out_of_range &) {
+  }
+  return mismatches;
+}
+
+void report(const char *step, List<int> &list)
+{
+  std::cout << step << ": " << checkPositions(list) << " mismatches" << std::endl;
+}
+
+void testListSkipIndex()
+{
+  List<int> list;
+  list.setSkipIndexStride(4);
+  report("empty", list);
+
+  // The first check builds the index, pushes at the front keep it up to date
+  for (int i = 0; i < 50; ++i) {
+    list.push_front(i);
+  }
+  report("push_front", list);
+  for (int i = 50; i < 57; ++i) {
+    list.push_front(i);
+  }
+  report("push_front (indexed)", list);
+
+  int values[] = { 100, 101 };
+  list.push_front(values, values + 2);
+  report("push_front range", list);
+
+  // Other modifications invalidate the index, which is rebuilt by the next access
+  list.pop_front();
+  list.pop_front();
+  list.pop_front();
+  report("pop_front", list);
+
+  list.insert_after(list.advance(list.begin(), 10), 1000);
+  list.erase_after(list.advance(list.begin(), 20));
+  report("insert_after/erase_after", list);
+
+  list.sort();
+  report("sort", list);
+  std::cout << "at(0): " << list.at(0) << ", at(10): " << list.at(10) << std::endl;
+
+  list.setSkipIndexStride(1);
+  report("stride 1", list);
+  list.setSkipIndexStride(0);
+  report("not indexed", list);
+}
+
+int main(int argc, char *argv[])
+{
+  testListSkipIndex();
+}
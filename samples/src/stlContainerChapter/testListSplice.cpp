@@ -0,0 +1,88 @@
+#include "List.h"
+
+#include <iostream>
+
+void printList(const List<int> &list)
+{
+  for (List<int>::ConstIterator it = list.begin(); it != list.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << std::endl;
+}
+
+void testListSplice()
+{
+  // The range keeps its order
+  int values[] = { 1, 2, 3 };
+  List<int> list;
+  list.push_front(9);
+  list.push_front(values, values + 3);
+  printList(list);
+
+  // Whole list after 1
+  List<int> other;
+  other.push_front(11);
+  other.push_front(10);
+  list.splice_after(list.begin(), other);
+  printList(list);
+  std::cout << "other: " << (other.begin() == other.end() ? "empty" : "not empty") << std::endl;
+
+  // 20 and 21, strictly between 19 and 22, after 9
+  for (int i = 22; i >= 19; --i) {
+    other.push_front(i);
+  }
+  list.splice_after(list.find(9), other, other.begin(), other.find(22));
+  printList(list);
+  printList(other);
+
+  // Within the list itself: Move the elements following 11 right after 1
+  list.splice_after(list.begin(), list, list.find(11), list.end());
+  printList(list);
+
+  // The range already follows position: Nothing moves
+  list.splice_after(list.begin(), list, list.begin(), list.end());
+  printList(list);
+
+  list.splice_front(other);
+  printList(list);
+}
+
+/**
+ * Compacted nodes of an arena list are ordinary arena nodes: They are spliced and merged into
+ * other lists of the arena without being copied, and the list can be compacted again afterwards
+ */
+void testCompactedListSplice()
+{
+  MonotonicArena arena;
+  List<int> compacted(arena);
+  for (int i = 5; i >= 1; --i) {
+    compacted.push_front(i);
+  }
+  compacted.compact();
+
+  // 2 and 3, strictly between 1 and 4, after 9
+  List<int> list(arena);
+  list.push_front(9);
+  list.splice_after(list.begin(), compacted, compacted.begin(), compacted.find(4));
+  printList(list);
+  printList(compacted);
+
+  List<int> sorted(arena);
+  sorted.push_front(6);
+  sorted.push_front(0);
+  sorted.merge(compacted);
+  printList(sorted);
+
+  compacted.push_front(7);
+  compacted.compact();
+  list.splice_after(list.begin(), compacted);
+  list.erase_after(list.begin());
+  list.compact();
+  printList(list);
+}
+
+int main(int argc, char *argv[])
+{
+  testListSplice();
+  testCompactedListSplice();
+}
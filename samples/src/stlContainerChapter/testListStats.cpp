@@ -0,0 +1,41 @@
+#include "List.h"
+#include "ListStats.h"
+
+#include <iostream>
+#include <string>
+
+void testListStats()
+{
+  typedef List<std::string, CountingListStats> CountedList;
+
+  CountingListStats::reset();
+  {
+    CountedList list;
+    for (int i = 0; i < 1000; ++i) {
+      list.push_front(std::to_string(i));
+    }
+
+    CountedList copy(list);
+    std::size_t length = 0;
+    for (CountedList::ConstIterator it = copy.begin(); it != copy.end(); ++it) {
+      length += it->size();
+    }
+    std::cout << "Total length: " << length << std::endl;
+
+    // Nodes moved between lists are accounted to the list they end up in
+    CountedList other;
+    other.push_front("extra");
+    list.splice_front(other);
+  }
+  printListStats(CountingListStats::snapshot());
+
+  // Without statistics, the policy takes no room
+  std::cout << "sizeof(List<int, NoListStats>): " << sizeof(List<int, NoListStats>)
+    << ", sizeof(List<int, CountingListStats>): " << sizeof(List<int, CountingListStats>)
+    << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testListStats();
+}
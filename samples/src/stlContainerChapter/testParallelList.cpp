@@ -0,0 +1,37 @@
+#include "List.h"
+#include "ParallelList.h"
+
+#include <iostream>
+
+void testParallelList()
+{
+  typedef List<int> IntList;
+
+  IntList list;
+  for (int i = 0; i < 100000; ++i) {
+    list.push_front(i);
+  }
+
+  // Scan the list several times with the same partition
+  ListPartition<IntList::Iterator> partition(list.begin(), list.end(), 1000);
+  std::cout << partition.segmentCount() << " segments" << std::endl;
+
+  parallel_for_each(partition, [](int &value) { value *= 2; });
+
+  long long sum = parallel_reduce(partition, 0LL, [](long long lhs, long long rhs) { return lhs + rhs; });
+  std::cout << "Sum: " << sum << std::endl;
+
+  std::size_t count = parallel_count_if(partition, [](int value) { return value % 3 == 0; });
+  std::cout << "Multiples of 3: " << count << std::endl;
+
+  // Without a partition
+  const IntList &constList = list;
+  int maxValue = parallel_reduce(constList.begin(), constList.end(), 0,
+    [](int lhs, int rhs) { return lhs < rhs ? rhs : lhs; });
+  std::cout << "Max: " << maxValue << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testParallelList();
+}
@@ -0,0 +1,67 @@
+#include "List.h"
+
+#include <iostream>
+#include <string>
+
+template<class ListType>
+void print(const ListType &list)
+{
+  for (typename ListType::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " ";
+  }
+  std::cout << std::endl;
+}
+
+void testPersistentList()
+{
+  typedef List<std::string> SList;
+
+  SList list;
+  list.push_front("Alice");
+  list.push_front("Bob");
+
+  // The snapshot shares both nodes with the list
+  SList snapshot(list);
+
+  // Shares Bob and Alice as its tail
+  list.push_front("Copernicus");
+
+  // Copernicus is not shared and is changed in place. Bob is cloned before being changed, Alice
+  // remains shared
+  SList::Iterator it = list.begin();
+  *it += " (1473)";
+  ++it;
+  *it += " (changed)";
+
+  print(list);
+  print(snapshot);
+  std::cout << std::endl;
+
+  // An iterator taken before a copy clones the nodes it reaches again, leaving the copy intact
+  SList::Iterator before = list.begin();
+  ++before;
+  SList copy(list);
+  *before += " (after copy)";
+  ++before;
+  *before += " (after copy)";
+
+  print(list);
+  print(copy);
+  std::cout << std::endl;
+
+  // Same with atomic reference counts
+  typedef List<std::string, AtomicRefCount> SharedSList;
+
+  SharedSList sharedList;
+  sharedList.push_front("Darwin");
+  SharedSList sharedSnapshot(sharedList);
+  *sharedList.begin() += " (changed)";
+
+  print(sharedList);
+  print(sharedSnapshot);
+}
+
+int main(int argc, char *argv[])
+{
+  testPersistentList();
+}
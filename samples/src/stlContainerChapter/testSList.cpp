@@ -21,7 +21,25 @@ void testSList()
   std::cout << std::endl;
 }
 
+void testPooledSList()
+{
+  // Nodes drawn from a pool, 64 nodes per chunk
+  SList list(64);
+
+  list.push_front("Alice");
+  list.push_front("Bob");
+  list.push_front("Copernicus");
+
+  // Copies get a pool of their own
+  SList copy(list);
+  for (SList::ConstIterator cit = copy.begin(); cit != copy.end(); ++cit) {
+    std::cout << *cit << std::endl;
+  }
+  std::cout << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
   testSList();
+  testPooledSList();
 }
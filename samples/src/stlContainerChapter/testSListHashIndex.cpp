@@ -0,0 +1,66 @@
+#include "SList.h"
+
+#include <iostream>
+
+void printLookup(const SList &list, const std::string &value)
+{
+  SList::ConstIterator cit = list.find(value);
+  std::cout << value << ": " << (cit != list.end() ? "found " + *cit : "not found") << std::endl;
+}
+
+void testSListHashIndex()
+{
+  SList list;
+  list.setHashIndexEnabled(true);
+  list.push_front("Dave");
+  list.push_front("Copernicus");
+  list.push_front("Bob");
+  list.push_front("Alice");
+
+  // The index was built when it was enabled, insertions and erasures keep it up to date
+  printLookup(list, "Bob");
+  list.insert_after(list.find("Bob"), "Ada");
+  list.erase_after(list.begin());
+  printLookup(list, "Ada");
+  printLookup(list, "Bob");
+
+  // Values are immutable: An element is replaced by inserting the new value and erasing the former
+  SList::Iterator it = list.insert_after(list.begin(), "Adam");
+  list.erase_after(it);
+  printLookup(list, "Ada");
+  printLookup(list, "Adam");
+
+  // Spliced elements move from one index to the other
+  SList other;
+  other.setHashIndexEnabled(true);
+  other.push_front("Grace");
+  other.push_front("Frank");
+  list.splice_after(list.begin(), other, other.begin(), other.end());
+  printLookup(list, "Grace");
+  printLookup(other, "Grace");
+  printLookup(other, "Frank");
+
+  // The copy gets an index of its own, filled as its nodes are created
+  SList copy(list);
+  copy.pop_front();
+  printLookup(copy, "Alice");
+  printLookup(list, "Alice");
+  std::cout << "index: " << list.hashIndexMemoryUsage() << " bytes" << std::endl;
+
+  // Dedup: only push values which are not in the list yet
+  const char *values[] = { "Eve", "Alice", "Eve", "Frank" };
+  for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    if (! list.contains(values[i])) {
+      list.push_front(values[i]);
+    }
+  }
+  for (SList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " ";
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testSListHashIndex();
+}
@@ -0,0 +1,42 @@
+#include "SList.h"
+
+#include <iostream>
+
+void printSList(const SList &list)
+{
+  for (SList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " ";
+  }
+  std::cout << std::endl;
+}
+
+void testSListRecycling()
+{
+  SList list;
+  list.push_front("Dave");
+  list.push_front("Copernicus");
+  list.push_front("Bob");
+  list.push_front("Alice");
+  printSList(list);
+
+  SList::Iterator it = list.insert_after(list.begin(), "Ada");
+  it = list.erase_after(it);
+  printSList(list);
+
+  list.erase_after(list.begin(), list.end());
+  list.pop_front();
+  std::cout << (list.begin() == list.end() ? "empty" : "not empty") << std::endl;
+
+  // Nodes drawn from a pool go back to it
+  SList pooledList(64);
+  pooledList.push_front("Alice");
+  pooledList.push_front("Bob");
+  pooledList.pop_front();
+  pooledList.push_front("Copernicus");
+  printSList(pooledList);
+}
+
+int main(int argc, char *argv[])
+{
+  testSListRecycling();
+}
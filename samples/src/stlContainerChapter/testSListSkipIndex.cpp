@@ -0,0 +1,89 @@
+#include "SList.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Compare at() and advance() with a plain walk of the list, from every position and for every
+ * distance up to past the end. Return the number of mismatches
+ */
+std::size_t checkPositions(SList &list)
+{
+  std::vector<SList::Iterator> walk;
+  for (SList::Iterator it = list.begin(); it != list.end(); ++it) {
+    walk.push_back(it);
+  }
+
+  const SList &constList = list;
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    mismatches += &list.at(i) != &*walk[i] || &constList.at(i) != &*walk[i];
+    for (std::size_t n = 0; i + n <= walk.size() + 1; ++n) {
+      SList::Iterator expected = i + n < walk.size() ? walk[i + n] : list.end();
+      mismatches += list.advance(walk[i], n) != expected
+        || constList.advance(walk[i], n) != expected;
+    }
+  }
+
+  try {
+    constList.at(walk.size());
+    ++mismatches;
+  }
+  catch (const std::out_of_range &) {
+  }
+  return mismatches;
+}
+
+void report(const char *step, SList &list)
+{
+  std::cout << step << ": " << checkPositions(list) << " mismatches" << std::endl;
+}
+
+void testSListSkipIndex()
+{
+  SList list;
+  list.setSkipIndexStride(4);
+  report("empty", list);
+
+  // The first check builds the index, pushes at the front keep it up to date
+  for (int i = 0; i < 50; ++i) {
+    list.push_front("value" + std::to_string(i));
+  }
+  report("push_front", list);
+  for (int i = 50; i < 57; ++i) {
+    list.push_front("value" + std::to_string(i));
+  }
+  report("push_front (indexed)", list);
+
+  std::vector<std::string> values;
+  values.push_back("first");
+  values.push_back("second");
+  list.push_front(values.begin(), values.end());
+  report("push_front range", list);
+
+  // Other modifications invalidate the index, which is rebuilt by the next access
+  list.pop_front();
+  list.pop_front();
+  list.pop_front();
+  report("pop_front", list);
+
+  list.insert_after(list.advance(list.begin(), 10), "inserted");
+  list.erase_after(list.advance(list.begin(), 20));
+  report("insert_after/erase_after", list);
+
+  list.sort();
+  report("sort", list);
+  std::cout << "at(0): " << list.at(0) << ", at(10): " << list.at(10) << std::endl;
+
+  list.setSkipIndexStride(1);
+  report("stride 1", list);
+  list.setSkipIndexStride(0);
+  report("not indexed", list);
+}
+
+int main(int argc, char *argv[])
+{
+  testSListSkipIndex();
+}
@@ -0,0 +1,106 @@
+#include "SList.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+void printSList(const SList &list)
+{
+  for (SList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " ";
+  }
+  std::cout << std::endl;
+}
+
+void testSListSplice()
+{
+  // The range keeps its order
+  std::vector<std::string> values;
+  values.push_back("Alice");
+  values.push_back("Bob");
+  values.push_back("Copernicus");
+  SList list;
+  list.push_front("Dave");
+  list.push_front(values.begin(), values.end());
+  printSList(list);
+
+  // Whole list after Alice
+  SList other;
+  other.push_front("Ben");
+  other.push_front("Ada");
+  list.splice_after(list.begin(), other);
+  printSList(list);
+  std::cout << "other: " << (other.begin() == other.end() ? "empty" : "not empty") << std::endl;
+
+  // Elements strictly between Alice and Copernicus of another list, after Dave
+  other.push_front(values.begin(), values.end());
+  SList::ConstIterator last = other.begin();
+  ++last;
+  ++last;
+  SList::ConstIterator position = list.begin();
+  while (*position != "Dave") {
+    ++position;
+  }
+  list.splice_after(position, other, other.begin(), last);
+  printSList(list);
+  printSList(other);
+
+  // Within the list itself: Move the elements following Ben right after Alice
+  SList::ConstIterator first = list.begin();
+  while (*first != "Ben") {
+    ++first;
+  }
+  list.splice_after(list.begin(), list, first, list.end());
+  printSList(list);
+
+  // The range already follows position: Nothing moves
+  list.splice_after(list.begin(), list, list.begin(), list.end());
+  printSList(list);
+
+  list.splice_front(other);
+  printSList(list);
+}
+
+/**
+ * Compacted nodes of an arena list are ordinary arena nodes: They are spliced and merged into
+ * other lists of the arena without being copied, and the list can be compacted again afterwards
+ */
+void testCompactedSListSplice()
+{
+  MonotonicArena arena;
+  SList compacted(arena);
+  compacted.push_front("Erin");
+  compacted.push_front("Dave");
+  compacted.push_front("Carol");
+  compacted.push_front("Bob");
+  compacted.push_front("Alice");
+  compacted.compact();
+
+  SList list(arena);
+  list.push_front("Zoe");
+  SList::ConstIterator last = compacted.begin();
+  ++last;
+  ++last;
+  list.splice_after(list.begin(), compacted, compacted.begin(), last);
+  printSList(list);
+  printSList(compacted);
+
+  SList sorted(arena);
+  sorted.push_front("Eve");
+  sorted.push_front("Brenda");
+  sorted.merge(compacted);
+  printSList(sorted);
+
+  compacted.push_front("Frank");
+  compacted.compact();
+  list.splice_front(compacted);
+  list.pop_front();
+  list.compact();
+  printSList(list);
+}
+
+int main(int argc, char *argv[])
+{
+  testSListSplice();
+  testCompactedSListSplice();
+}
@@ -0,0 +1,31 @@
+#include "SList.h"
+#include "ListStats.h"
+
+#include <iostream>
+
+/**
+ * Built with LIST_STATS defined to 1, so that SList collects statistics
+ */
+void testSListStats()
+{
+  CountingListStats::reset();
+  {
+    SList list(64);
+    list.push_front("Alice");
+    list.push_front("Bob");
+    list.push_front("Copernicus");
+
+    SList copy;
+    copy = list;
+    for (SList::ConstIterator cit = copy.begin(); cit != copy.end(); ++cit) {
+      std::cout << *cit << std::endl;
+    }
+    copy.sort();
+  }
+  printListStats(CountingListStats::snapshot());
+}
+
+int main(int argc, char *argv[])
+{
+  testSListStats();
+}
@@ -1,8 +1,99 @@
 #include "List.h"
 
+#include <cstddef>
 #include <iostream>
+#include <memory>
 #include <string>
 
+namespace {
+
+/**
+ * Allocator drawing from the heap, whose instances compare equal only if they have the same tag.
+ * It does not propagate on move assignment, so that a list moved into another one with a
+ * different tag has to move the values into nodes of its own
+ */
+template<class T>
+class TaggedAllocator {
+public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+
+  template<class U>
+  struct rebind {
+    typedef TaggedAllocator<U> other;
+  };
+
+  explicit TaggedAllocator(int tag)
+  : m_tag(tag)
+  {}
+
+  template<class U>
+  TaggedAllocator(const TaggedAllocator<U> &rhs)
+  : m_tag(rhs.tag())
+  {}
+
+  T *allocate(std::size_t n)
+  {
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t /*n*/)
+  {
+    ::operator delete(p);
+  }
+
+  int tag() const
+  {
+    return m_tag;
+  }
+
+  template<class U>
+  friend bool operator==(const TaggedAllocator &lhs, const TaggedAllocator<U> &rhs)
+  {
+    return lhs.tag() == rhs.tag();
+  }
+  template<class U>
+  friend bool operator!=(const TaggedAllocator &lhs, const TaggedAllocator<U> &rhs)
+  {
+    return lhs.tag() != rhs.tag();
+  }
+
+private:
+  int m_tag;
+};
+
+/**
+ * Value counting the copies made of it
+ */
+struct Counted {
+  explicit Counted(int value)
+  : m_value(value)
+  {}
+
+  Counted(const Counted &rhs)
+  : m_value(rhs.m_value)
+  {
+    ++s_copyCount;
+  }
+
+  Counted(Counted &&rhs) noexcept
+  : m_value(rhs.m_value)
+  {}
+
+  int m_value;
+
+  static int s_copyCount;
+};
+
+int Counted::s_copyCount = 0;
+
+}
+
 void testStdSList()
 {
   typedef List<std::string> SList;
@@ -12,6 +103,10 @@ void testStdSList()
   list.push_front("Alice");
   list.push_front("Bob");
   list.push_front("Copernicus");
+
+  // Temporaries are moved into the list, values can also be constructed in place
+  list.push_front(std::string("Darwin"));
+  list.emplace_front(3, 'E');
   
   for (SList::const_iterator cit = list.begin(); cit != list.end(); ++cit) {
     std::cout << *cit << std::endl;
@@ -24,7 +119,48 @@ void testStdSList()
   std::cout << std::endl;
 }
 
+/**
+ * Moving a list never copies its elements: The nodes are stolen if the allocators allow it, and
+ * the values are moved into new nodes otherwise. The source is left empty
+ */
+void testStdSListMove()
+{
+  typedef List<Counted, TaggedAllocator<Counted> > CountedList;
+
+  CountedList list((TaggedAllocator<Counted>(1)));
+  list.emplace_front(2);
+  list.emplace_front(1);
+
+  CountedList moved(std::move(list));
+  std::cout << "move constructed: " << moved.begin()->m_value << ", source "
+    << (list.begin() == list.end() ? "empty" : "not empty") << std::endl;
+
+  // Same tag: The nodes are stolen
+  CountedList sameTag((TaggedAllocator<Counted>(1)));
+  sameTag = std::move(moved);
+  std::cout << "move assigned, same allocator: " << sameTag.begin()->m_value << ", source "
+    << (moved.begin() == moved.end() ? "empty" : "not empty") << std::endl;
+
+  // Other tag: The values are moved into nodes of the other allocator, which is kept
+  CountedList otherTag((TaggedAllocator<Counted>(2)));
+  otherTag = std::move(sameTag);
+  std::cout << "move assigned, other allocator: " << otherTag.begin()->m_value << ", source "
+    << (sameTag.begin() == sameTag.end() ? "empty" : "not empty") << ", allocator "
+    << otherTag.get_allocator().tag() << std::endl;
+  std::cout << "copies: " << Counted::s_copyCount << std::endl;
+
+  // Move-only values can be moved between allocators as well
+  typedef List<std::unique_ptr<int>, TaggedAllocator<std::unique_ptr<int> > > PointerList;
+  PointerList pointers((TaggedAllocator<std::unique_ptr<int> >(1)));
+  pointers.emplace_front(new int(42));
+  PointerList otherPointers((TaggedAllocator<std::unique_ptr<int> >(2)));
+  otherPointers = std::move(pointers);
+  std::cout << "move-only: " << **otherPointers.begin() << std::endl;
+  std::cout << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
   testStdSList();
+  testStdSListMove();
 }
@@ -0,0 +1,46 @@
+#include "List.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+typedef List<std::string, std::allocator<std::string>, TailTracking> TailList;
+
+void printList(const TailList &list)
+{
+  for (TailList::const_iterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " ";
+  }
+  std::cout << "(" << list.size() << ")" << std::endl;
+}
+
+void testStdListTailTracking()
+{
+  TailList list;
+
+  // Appending to an empty list sets its first node as well
+  list.push_back("Bob");
+  list.push_front("Alice");
+  list.push_back(std::string("Copernicus"));
+  list.emplace_back(3, 'D');
+  printList(list);
+
+  // The nodes of other are relinked after ours, other is left empty
+  TailList other;
+  other.push_back("Eve");
+  other.push_back("Frank");
+  list.append(std::move(other));
+  printList(list);
+  printList(other);
+
+  // The moved-to list keeps tracking the tail
+  TailList moved(std::move(list));
+  moved.push_back("Grace");
+  printList(moved);
+  printList(list);
+}
+
+int main(int argc, char *argv[])
+{
+  testStdListTailTracking();
+}
@@ -0,0 +1,29 @@
+#include "SList.h"
+
+#include <iostream>
+#include <string>
+
+void testStringViewSList()
+{
+  SList list;
+
+  list.push_front("Alice");
+  list.push_front(std::string("Bob"));
+  list.push_front("A string too long to fit in the std::string small buffer");
+
+  for (SList::ConstIterator cit = list.begin(); cit != list.end(); ++cit) {
+    std::cout << *cit << " (" << cit->size() << ")" << std::endl;
+  }
+  std::cout << std::endl;
+
+  SList copy(list);
+  for (SList::Iterator it = copy.begin(); it != copy.end(); ++it) {
+    std::cout << *it << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  testStringViewSList();
+}